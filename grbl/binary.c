@@ -0,0 +1,239 @@
+/*
+  binary.c - compact binary motion record protocol
+  Part of Grbl
+
+  Copyright (c) 2026 agent
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "grbl.h"
+
+#ifdef ENABLE_BINARY_PROTOCOL
+
+// Receive state of the current frame
+#define BINARY_FLAG_ESCAPE   bit(0)
+#define BINARY_FLAG_OVERFLOW bit(1)
+
+// Variable length integer encoding
+#define BINARY_VALUE_MASK 0x3f
+#define BINARY_VALUE_MORE bit(6)
+#define BINARY_VALUE_MAX_SHIFT 24 // Five bytes. Up to 30 bits.
+
+static uint8_t binary_frame[BINARY_FRAME_SIZE];
+static uint8_t binary_length; // Received record bytes, after removing the escapes.
+static uint8_t binary_flags;
+
+static int32_t binary_position[N_AXIS]; // Target of the previous motion record in microns.
+static float binary_feed[BINARY_FEED_TABLE_SIZE]; // Feed rates in mm/min. Zero until set.
+static uint8_t binary_feed_index;
+
+
+void binary_start()
+{
+  uint8_t idx;
+  for (idx=0; idx<N_AXIS; idx++) { binary_position[idx] = lround(1000.0*gc_state.position[idx]); }
+  memset(binary_feed, 0, sizeof(binary_feed));
+  binary_feed_index = 0;
+  binary_length = 0;
+  binary_flags = 0;
+  sys.binary_mode = true;
+}
+
+
+uint8_t binary_read(uint8_t data)
+{
+  if (data == BINARY_FRAME_END) { return(true); }
+  if (data == BINARY_FRAME_ESC) {
+    binary_flags |= BINARY_FLAG_ESCAPE;
+    return(false);
+  }
+  if (binary_flags & BINARY_FLAG_ESCAPE) {
+    binary_flags &= ~(BINARY_FLAG_ESCAPE);
+    data ^= BINARY_FRAME_ESC_XOR;
+  }
+  if (binary_length < BINARY_FRAME_SIZE) { binary_frame[binary_length++] = data; }
+  else { binary_flags |= BINARY_FLAG_OVERFLOW; }
+  return(false);
+}
+
+
+// CRC-7 as used by SD cards. Computed in the upper seven bits, so the polynomial is shifted left.
+static uint8_t binary_crc7(uint8_t length)
+{
+  uint8_t crc = 0;
+  uint8_t idx, n;
+  for (idx=0; idx<length; idx++) {
+    crc ^= binary_frame[idx];
+    for (n=0; n<8; n++) {
+      if (crc & 0x80) { crc = (crc << 1) ^ (0x09 << 1); }
+      else { crc <<= 1; }
+    }
+  }
+  return(crc >> 1);
+}
+
+
+// Reads an unsigned variable length integer at index idx of the record. Returns false, if it
+// runs past the end of the record or is too long.
+static uint8_t binary_read_uint(uint8_t *idx, uint8_t length, uint32_t *value)
+{
+  uint32_t result = 0;
+  uint8_t shift = 0;
+  uint8_t data;
+  do {
+    if ((*idx >= length) || (shift > BINARY_VALUE_MAX_SHIFT)) { return(false); }
+    data = binary_frame[(*idx)++];
+    result |= (uint32_t)(data & BINARY_VALUE_MASK) << shift;
+    shift += 6;
+  } while (data & BINARY_VALUE_MORE);
+  *value = result;
+  return(true);
+}
+
+
+// Reads a zigzag encoded signed variable length integer.
+static uint8_t binary_read_int(uint8_t *idx, uint8_t length, int32_t *value)
+{
+  uint32_t zigzag;
+  if (!binary_read_uint(idx, length, &zigzag)) { return(false); }
+  *value = (int32_t)(zigzag >> 1) ^ -(int32_t)(zigzag & 1);
+  return(true);
+}
+
+
+// Validates and executes a record of length bytes, excluding the CRC.
+static uint8_t binary_execute_record(uint8_t length)
+{
+  uint8_t header = binary_frame[0];
+  uint8_t type = header & BINARY_HEADER_TYPE_MASK;
+  uint8_t idx = 1;
+  switch (type) {
+    case BINARY_RECORD_EXIT:
+      if (length != 1) { return(STATUS_INVALID_STATEMENT); }
+      sys.binary_mode = false;
+      return(STATUS_OK);
+    case BINARY_RECORD_FEED: {
+      uint32_t feed_rate;
+      if (length < 2) { return(STATUS_INVALID_STATEMENT); }
+      uint8_t feed_index = binary_frame[idx++];
+      if (feed_index >= BINARY_FEED_TABLE_SIZE) { return(STATUS_INVALID_STATEMENT); }
+      if (!binary_read_uint(&idx, length, &feed_rate) || (idx != length)) { return(STATUS_INVALID_STATEMENT); }
+      binary_feed[feed_index] = 0.1*feed_rate;
+      return(STATUS_OK);
+    }
+    case BINARY_RECORD_RAPID: case BINARY_RECORD_LINE: case BINARY_RECORD_CW_ARC: case BINARY_RECORD_CCW_ARC:
+      break;
+    default: return(STATUS_INVALID_STATEMENT);
+  }
+
+  // Decode the whole motion record, before changing any state.
+  uint8_t feed_index = binary_feed_index;
+  if (header & BINARY_HEADER_FEED) {
+    if (idx >= length) { return(STATUS_INVALID_STATEMENT); }
+    feed_index = binary_frame[idx++];
+    if (feed_index >= BINARY_FEED_TABLE_SIZE) { return(STATUS_INVALID_STATEMENT); }
+  }
+  int32_t position[N_AXIS];
+  int32_t delta;
+  uint8_t axis;
+  for (axis=0; axis<N_AXIS; axis++) {
+    position[axis] = binary_position[axis];
+    if ((header >> BINARY_HEADER_AXIS_BIT) & bit(axis)) {
+      if (!binary_read_int(&idx, length, &delta)) { return(STATUS_INVALID_STATEMENT); }
+      position[axis] += delta;
+    }
+  }
+  float target[N_AXIS];
+  for (axis=0; axis<N_AXIS; axis++) { target[axis] = 0.001*position[axis]; }
+
+  float offset[N_AXIS];
+  float radius = 0.0;
+  uint8_t axis_0, axis_1, axis_linear;
+  switch (gc_state.modal.plane_select) {
+    case PLANE_SELECT_XY: axis_0 = X_AXIS; axis_1 = Y_AXIS; axis_linear = Z_AXIS; break;
+    case PLANE_SELECT_ZX: axis_0 = Z_AXIS; axis_1 = X_AXIS; axis_linear = Y_AXIS; break;
+    default: axis_0 = Y_AXIS; axis_1 = Z_AXIS; axis_linear = X_AXIS; // case PLANE_SELECT_YZ:
+  }
+  if ((type == BINARY_RECORD_CW_ARC) || (type == BINARY_RECORD_CCW_ARC)) {
+    int32_t offset_0, offset_1;
+    if (!binary_read_int(&idx, length, &offset_0) || !binary_read_int(&idx, length, &offset_1)) {
+      return(STATUS_INVALID_STATEMENT);
+    }
+    if ((offset_0 == 0) && (offset_1 == 0)) { return(STATUS_GCODE_NO_OFFSETS_IN_PLANE); }
+    memset(offset, 0, sizeof(offset));
+    offset[axis_0] = 0.001*offset_0;
+    offset[axis_1] = 0.001*offset_1;
+
+    // Same arc definition error check as the g-code parser.
+    radius = hypot_f(offset[axis_0], offset[axis_1]);
+    float target_r = hypot_f(target[axis_0]-gc_state.position[axis_0]-offset[axis_0],
+                             target[axis_1]-gc_state.position[axis_1]-offset[axis_1]);
+    float delta_r = fabs(target_r-radius);
+    if (delta_r > 0.005) {
+      if (delta_r > 0.5) { return(STATUS_GCODE_INVALID_TARGET); }
+      if (delta_r > (0.001*radius)) { return(STATUS_GCODE_INVALID_TARGET); }
+    }
+  }
+  if (idx != length) { return(STATUS_INVALID_STATEMENT); }
+  if ((type != BINARY_RECORD_RAPID) && (binary_feed[feed_index] == 0.0)) { return(STATUS_GCODE_UNDEFINED_FEED_RATE); }
+
+  // Execute the motion with the parser spindle and coolant state.
+  plan_line_data_t plan_data;
+  plan_line_data_t *pl_data = &plan_data;
+  memset(pl_data,0,sizeof(plan_line_data_t));
+  pl_data->feed_rate = binary_feed[feed_index];
+  if (bit_isfalse(settings.flags,BITFLAG_LASER_MODE) || (type != BINARY_RECORD_RAPID)) {
+    pl_data->spindle_speed = gc_state.spindle_speed;
+  }
+  pl_data->condition = (gc_state.modal.spindle | gc_state.modal.coolant);
+  switch (type) {
+    case BINARY_RECORD_RAPID:
+      pl_data->condition |= PL_COND_FLAG_RAPID_MOTION;
+      #ifdef INDEPENDENT_AXIS_RAPIDS
+        mc_rapid(target, pl_data, gc_state.position);
+      #else
+        mc_line(target, pl_data);
+      #endif
+      break;
+    case BINARY_RECORD_LINE:
+      mc_line(target, pl_data);
+      break;
+    default:
+      mc_arc(target, pl_data, gc_state.position, offset, radius, axis_0, axis_1, axis_linear,
+          (type == BINARY_RECORD_CW_ARC));
+  }
+  memcpy(binary_position, position, sizeof(position));
+  binary_feed_index = feed_index;
+  memcpy(gc_state.position, target, sizeof(target));
+  return(STATUS_OK);
+}
+
+
+uint8_t binary_execute_frame()
+{
+  uint8_t status_code = STATUS_OK; // Empty frame. For syncing purposes.
+  if (binary_flags & BINARY_FLAG_OVERFLOW) {
+    status_code = STATUS_OVERFLOW;
+  } else if (binary_length) {
+    uint8_t length = binary_length-1;
+    if ((length == 0) || (binary_crc7(length) != binary_frame[length])) { status_code = STATUS_BINARY_CRC_ERROR; }
+    else { status_code = binary_execute_record(length); }
+  }
+  binary_length = 0;
+  binary_flags = 0;
+  return(status_code);
+}
+
+#endif
@@ -0,0 +1,74 @@
+/*
+  binary.h - compact binary motion record protocol
+  Part of Grbl
+
+  Copyright (c) 2026 agent
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef binary_h
+#define binary_h
+
+#ifdef ENABLE_BINARY_PROTOCOL
+
+// Binary mode is entered with the CMD_BINARY_MODE realtime command, which is answered with 'ok' at
+// its place in the stream. Each record is then sent as a frame, ended by BINARY_FRAME_END and
+// answered with 'ok' or an error, like a g-code line. The realtime command characters, including
+// all extended ASCII, and the frame end and escape characters are sent as BINARY_FRAME_ESC followed
+// by the character XOR BINARY_FRAME_ESC_XOR. All other frame bytes are below 0x80, so realtime
+// commands are still picked off the stream. A frame holds a record and its CRC:
+//
+//   header   Record type in bits 0-2. Motions set bit 3+axis for each axis moved and bit 6, if a
+//            feed table index follows.
+//   feed     Feed table index (0-7). Kept for the following motions. Motions only, if bit 6 set.
+//   values   Variable length integers of 6 bit groups, least significant first, with bit 6 set on
+//            all but the last byte. Signed values are zigzag encoded (0,-1,1,-2,...).
+//            Motions: signed axis move in microns for each axis set in the header. Arcs follow
+//            with the signed center offsets along the first and second axis of the active plane.
+//            Feed: table index byte, then the unsigned feed rate in 0.1mm/min.
+//   crc      CRC-7 of all preceding record bytes. Polynomial x^7+x^3+1, initial value zero.
+//
+// Motions are in machine coordinates relative to the previous record, starting at the g-code
+// parser position, and leave the parser modal state unchanged.
+#define BINARY_FRAME_END     0x0D
+#define BINARY_FRAME_ESC     0x1B
+#define BINARY_FRAME_ESC_XOR 0x40
+#define BINARY_FRAME_SIZE    28 // Largest record, an arc moving all axes with 5 byte values, and CRC.
+
+// Binary record types and header bits
+#define BINARY_RECORD_RAPID     0 // G0
+#define BINARY_RECORD_LINE      1 // G1
+#define BINARY_RECORD_CW_ARC    2 // G2
+#define BINARY_RECORD_CCW_ARC   3 // G3
+#define BINARY_RECORD_FEED      4 // Sets a feed table entry.
+#define BINARY_RECORD_EXIT      7 // Returns to g-code line input.
+#define BINARY_HEADER_TYPE_MASK 0x07
+#define BINARY_HEADER_AXIS_BIT  3
+#define BINARY_HEADER_FEED      bit(6)
+
+#define BINARY_FEED_TABLE_SIZE  8
+
+// Enters binary mode at the parser position, with an empty feed table.
+void binary_start();
+
+// Adds a received character to the current frame. Returns true, when the frame is complete.
+uint8_t binary_read(uint8_t data);
+
+// Executes the record of the completed frame and readies the next frame.
+uint8_t binary_execute_frame();
+
+#endif
+
+#endif
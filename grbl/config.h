@@ -63,6 +63,7 @@
 #define CMD_SAFETY_DOOR 0x84
 #define CMD_JOG_CANCEL  0x85
 #define CMD_DEBUG_REPORT 0x86 // Only when DEBUG enabled, sends debug report in '{}' braces.
+#define CMD_BINARY_MODE 0x87 // Only when ENABLE_BINARY_PROTOCOL enabled. Switches to binary motion records.
 #define CMD_FEED_OVR_RESET 0x90         // Restores feed override value to 100%.
 #define CMD_FEED_OVR_COARSE_PLUS 0x91
 #define CMD_FEED_OVR_COARSE_MINUS 0x92
@@ -116,6 +117,24 @@
 // greater.
 #define N_HOMING_LOCATE_CYCLE 1 // Integer (1-128)
 
+// Latches the machine position in the limit pin change interrupt at the moment a switch triggers
+// during the homing approach, the way the probe latches its position, and stops the axis at once.
+// The polled trigger point is only as precise as the homing loop, which is why the slow locate
+// cycles exist. With the latch, the locate cycles are skipped and the axes pull off from the exact
+// latched trigger point after the seek approach. The homing feed rate setting is then unused.
+// NOTE: Requires a clean limit switch signal. Not supported with software debounce, CoreXY or the
+// dual axis feature.
+// #define HOMING_LATCH_TRIGGER_POSITION // Default disabled. Uncomment to enable.
+
+// Homes the axes of all the HOMING_CYCLE_x defines above together in one cycle, rather than one
+// cycle after another, so homing takes as long as the slowest axis. Each axis seeks and locates at
+// its own homing rates, set by the per-axis '$140-$142' feed and '$150-$152' seek settings, and is
+// stopped by its own limit switch. The axes pull off together. The acceleration settings of each
+// axis are obeyed. The $24 and $25 homing rate settings are not used.
+// NOTE: Z no longer clears the workspace before X and Y move. Changes the EEPROM settings layout,
+// so the settings are restored to defaults when this is first enabled. Not supported with CoreXY.
+// #define HOMING_PARALLEL_AXES // Default disabled. Uncomment to enable.
+
 // Enables single axis homing commands. $HX, $HY, and $HZ for X, Y, and Z-axis homing. The full homing 
 // cycle is still invoked by the $H command. This is disabled by default. It's here only to address
 // users that need to switch between a two-axis and three-axis machine. This is actually very rare.
@@ -302,6 +321,36 @@
 // step smoothing. See stepper.c for more details on the AMASS system works.
 #define ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING  // Default enabled. Comment to disable.
 
+// Computes the step rate of each step segment with integer math instead of a float division and ceil().
+// Step distances are carried in Q24.8 fixed-point and segment times and partial step times in timer
+// cycles. The velocity profile square roots use an integer square root. Both are seeded by small lookup
+// tables. The ramp distance and time math stays in float, but divides only per block and where a
+// segment crosses a ramp junction. Intended for processors without an FPU, where these calls take a
+// large share of st_prep_buffer() time. Step rates match the float version, except where float rounds
+// a whole number of timer cycles per step on its own round-off. Block totals are exact.
+// #define FIXED_POINT_SEGMENT_GENERATOR // Default disabled. Uncomment to enable.
+
+// Enables multi-step burst mode for very high step rates. Above the burst cutoff frequency, the stepper
+// ISR emits up to 2^STEP_BURST_MAX_LEVEL step pulses per interrupt, as a tight pulse train spaced by the
+// $0 pulse time high and low, rather than a single pulse. This raises the achievable step rate for
+// high-microstepping drivers without raising the interrupt overhead proportionally. The ISR spends about
+// two pulse times per extra step of a burst, so keep $0 as short as the drivers allow. The cutoff must
+// be at least twice the AMASS level 1 cutoff (8kHz), and step periods must be longer than twice $0.
+// NOTE: Not compatible with STEP_PULSE_DELAY.
+// #define STEP_BURST_MODE // Default disabled. Uncomment to enable.
+#define STEP_BURST_CUTOFF_HZ 20000 // Step rates above this frequency are burst. (Hz)
+#define STEP_BURST_MAX_LEVEL 2 // Maximum burst of 2^level steps per ISR tick. Integer (1-3)
+
+// Replaces the variable-rate Bresenham step generation with a fixed-frequency DDA (digital differential
+// analyzer) step engine. The stepper ISR runs at a constant DDA_TICK_FREQUENCY, and each axis advances a
+// 32-bit phase accumulator by an increment computed per segment in st_prep_buffer(), stepping when it
+// overflows. Every axis steps at its own evenly spaced rate, which removes multi-axis aliasing at low step
+// rates without AMASS, and the ISR load is constant. The trade-offs are up to one tick of step timing
+// jitter and a maximum step rate per axis below the tick frequency. Steps executed are exact per segment.
+// NOTE: Requires ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING disabled. Not compatible with STEP_BURST_MODE.
+// #define DDA_STEP_ENGINE // Default disabled. Uncomment to enable.
+#define DDA_TICK_FREQUENCY 25000 // Stepper ISR frequency of the DDA step engine. (Hz)
+
 // Sets the maximum step rate allowed to be written as a Grbl setting. This option enables an error
 // check in the settings module to prevent settings values that will exceed this limitation. The maximum
 // step rate is strictly limited by the CPU speed and will change if something other than an AVR running
@@ -395,6 +444,131 @@
 // bogged down by too many trig calculations.
 #define N_ARC_CORRECTION 12 // Integer (1-255)
 
+// Queues each G2/G3 arc as a single planner block instead of splitting it into many short line
+// segments. The step segment generator traces the true arc, converting the executed arc distance to
+// an arc point every step segment and stepping the chord to it. The arc tolerance setting limits the
+// segment length. This removes the chord junctions, so arcs run at the full feed rate up to the
+// centripetal acceleration limit and no longer fill the planner buffer.
+// NOTE: Each planner block grows by 20 bytes, which will use ~320 bytes of RAM with the default
+// buffer size. Not supported with CoreXY or the DDA step engine.
+// #define NATIVE_ARC_BLOCKS // Default disabled. Uncomment to enable.
+
+// Enables G5 cubic and G5.1 quadratic spline motions in the G17 XY plane, as defined by LinuxCNC. A
+// spline is flattened into line motions like an arc, where the segment length adapts to the local
+// curvature of the spline to keep each segment within the arc tolerance setting. As with LinuxCNC,
+// I and J may be omitted on a G5 that follows another G5, which continues the curve smoothly.
+// NOTE: Adds roughly 1.5KB of flash, which does not fit on a 328p with all default features enabled.
+// #define ENABLE_G5_SPLINES // Default disabled. Uncomment to enable.
+#define SPLINE_MIN_SEGMENT_T 0.002 // Float (0-1). Minimum spline parameter step. Bounds segment count.
+
+// Enables the G73, G81, G82 and G83 canned drilling cycles with G80 cancel and G98/G99 retract modes,
+// as defined by LinuxCNC in the G17 XY plane. A drilling line is expanded into its rapid and feed
+// motions by Grbl, and the Z, R, P and Q words are retained for the following holes of the cycle.
+// The G82 dwell is queued in the planner as a timed block without motion, so it does not force a
+// buffer sync. G73 chip-break retracts and G83 peck re-approaches stop short of the last depth by
+// the peck clearance below.
+// NOTE: Adds roughly 1.5KB of flash, which does not fit on a 328p with all default features enabled.
+// #define ENABLE_CANNED_CYCLES // Default disabled. Uncomment to enable.
+#define CANNED_CYCLE_PECK_CLEARANCE 0.254 // Float (mm). G73 retract and G83 re-approach clearance.
+
+// Queues a G4 dwell in the planner buffer as a zero-motion timed block, instead of waiting for the
+// buffer to empty and delaying in the main loop. The step segment generator times the dwell with
+// idle segments, so the blocks before and after it stay in the buffer and the serial stream keeps
+// flowing. The motion before the dwell still decelerates to a stop. Feed hold pauses the dwell.
+// NOTE: G4 P0 still waits for the buffer to empty, since hosts use it to sync with motion.
+// #define PLANNED_DWELL // Default disabled. Uncomment to enable.
+
+// Applies spindle and coolant changes with the motion that follows them, instead of emptying the
+// planner buffer to stop the machine first. Each planner block already carries the programmed spindle
+// and coolant state, and the stepper sets the outputs when it starts a block with a new state, as
+// it does for the spindle PWM. A change with no motion after it is applied when the buffer empties.
+// NOTE: Spindle spin-up is not waited for, so programs relying on the sync should dwell after M3/M4.
+// Spindle changes are still synced in laser mode.
+// #define PLANNED_ACCESSORY_STATE // Default disabled. Uncomment to enable.
+
+// Executes G0 rapids with each axis moving at its own maximum rate, instead of as a straight line
+// limited by the slowest axis. The rapid is queued as a dogleg of up to three lines. The first moves
+// all axes at their max rates until the shortest axis move ends, and the next continue with the axes
+// left. Every dogleg point is soft limit checked before any line is queued. Acceleration is still
+// limited per line by the slowest moving axis, as with any planner block.
+// NOTE: The tool path of a rapid is no longer a straight line. Check fixture clearances before use.
+// #define INDEPENDENT_AXIS_RAPIDS // Default disabled. Uncomment to enable.
+
+// Enables backlash compensation with per-axis backlash settings $160-$162 in mm. When a line motion
+// reverses an axis, the planner first queues a short rapid compensation block for the reversing axes.
+// The block is planned like any other line, so it blends with the motions around it, and its steps
+// are not counted into the machine position. The axis direction state is set by homing to the
+// pull-off direction, and is otherwise assumed positive after power-up.
+// NOTE: The laser is off during compensation blocks in laser mode. Not supported with CoreXY or
+// NATIVE_ARC_BLOCKS.
+// #define ENABLE_BACKLASH_COMPENSATION // Default disabled. Uncomment to enable.
+
+// Enables height-map mesh leveling for PCB isolation routing and engraving on warped stock. A grid of
+// Z offsets is defined with the '$M' commands and may be saved to EEPROM with '$MW', which is then
+// loaded on power-up. '$MP' probes every grid point in one firmware routine and prints the resulting
+// mesh when done, instead of streaming a G38.2 line per point. While enabled, every line motion is
+// split where it crosses the grid lines and each segment end point is raised by the bilinearly
+// interpolated offset, so the host can stream the unmodified program. Reported and g-code parser
+// positions have the offset removed. Homing and parking motions are not compensated.
+// NOTE: The mesh uses 4 bytes of RAM per grid point. Not supported with NATIVE_ARC_BLOCKS.
+// #define ENABLE_MESH_LEVELING // Default disabled. Uncomment to enable.
+#define MESH_POINTS_X 5 // Integer (2-16). Number of grid points along X.
+#define MESH_POINTS_Y 5 // Integer (2-16). Number of grid points along Y.
+
+// Executes lines with only X, Y, Z, F and N words in G0 or G1 and G94 mode, like most lines of 3D
+// surfacing and raster programs, without the full g-code parser. The words are converted to a target
+// and passed to the motion planner directly, skipping the parser block setup and the error checks
+// that cannot apply to them. Any other line, or one that would fail a check, uses the full parser.
+// #define AXIS_LINE_FAST_PATH // Default disabled. Uncomment to enable.
+
+// Queues parsed line motions while the planner buffer is full, instead of waiting in the parser for
+// room. The parser keeps working on the next lines, so when a block completes, the planner takes the
+// next motion from the queue rather than waiting for a full line parse. Jog, probe and native arc
+// motions, dwells and buffer syncs empty the queue into the planner first, keeping the order.
+// NOTE: Each queued motion uses about 25 bytes of RAM.
+// #define PARSE_AHEAD_QUEUE // Default disabled. Uncomment to enable.
+#define PARSE_AHEAD_QUEUE_SIZE 4 // Integer (1-255). Number of parsed motions held for the planner.
+
+// Adds a compact binary input mode for streaming motions. After the CMD_BINARY_MODE realtime command,
+// the host sends framed records of a motion type, axis moves in microns relative to the previous
+// record, a feed table index and a CRC, instead of g-code lines. A typical line motion takes 7 to 10
+// bytes rather than 25 or more, and records are handed to the motion control functions without the
+// g-code parser. Each record is answered like a g-code line. See binary.h for the record format.
+// NOTE: Not supported with RX_BUFFER_LINE_PARSING. A reset returns to g-code line input.
+// #define ENABLE_BINARY_PROTOCOL // Default disabled. Uncomment to enable.
+
+// Treats a line of only '%' as a program start or end delimiter. While a program runs, Grbl expects
+// more lines to follow, so an empty serial read buffer no longer auto-starts the cycle with the few
+// blocks queued so far. The cycle starts when the planner buffer fills, at a buffer sync, such as
+// M0 or a dwell, or at the program end. The status report shows 'Run' instead of 'Idle' until the
+// ending '%', M2 or M30. Cycle start still runs the queued blocks at any time.
+// NOTE: '$' commands requiring the IDLE state, jogging and '$C' return an idle error until then.
+// #define ENABLE_PROGRAM_MODE // Default disabled. Uncomment to enable.
+
+// Defers the auto-cycle start, when the serial read buffer runs empty, until the planner buffer holds
+// DEFERRED_START_BLOCKS blocks or DEFERRED_START_DISTANCE of motion, or no more data is received for
+// DEFERRED_START_TIMEOUT. The first moves of a job, or after a buffer sync, are then planned with
+// the lines a slow host sends next, instead of stopping at the end of the first one or two blocks.
+// A single block with no more data received, such as a command sent by hand, and a full planner
+// buffer still start at once.
+// #define DEFERRED_CYCLE_START // Default disabled. Uncomment to enable.
+#define DEFERRED_START_BLOCKS 6 // Integer (1-255). Planner blocks to start the cycle.
+#define DEFERRED_START_DISTANCE 10.0 // Float (mm). Planned motion to start the cycle.
+#define DEFERRED_START_TIMEOUT 50 // Integer (1-255) milliseconds without received data to start.
+
+// Adds O-word subprograms stored in EEPROM. The lines between 'O<n> sub' and 'O<n> endsub' are stored
+// instead of executed, replacing any stored subprogram <n>, and 'O<n> call' executes them. Stored
+// subprograms may call others and contain 'O<n> repeat [count]' to 'O<n> endrepeat' blocks. Part
+// geometry repeated in a job is then sent and parsed once. A definition without lines deletes it.
+// NOTE: Subprograms share the 255 bytes of EEPROM space of the leveling mesh, so the two are not
+// supported together. Repeat blocks are only supported in stored subprograms. Defining a subprogram
+// waits for the buffered motions to complete, since EEPROM writes stall the step interrupts. Each
+// stored byte takes 3.4ms to write. The serial receive interrupt keeps running meanwhile, so the
+// definition may be streamed by character counting, which then simply waits for the 'ok' responses.
+// A redefinition replaces the stored subprogram only when it ends, and needs space for both.
+// #define ENABLE_SUBPROGRAMS // Default disabled. Uncomment to enable.
+#define SUBPROGRAM_MAX_DEPTH 4 // Integer (1-255). Nesting levels of calls and repeat blocks.
+
 // The arc G2/3 g-code standard is problematic by definition. Radius-based arcs have horrible numerical
 // errors when arc at semi-circles(pi) or full-circles(2*pi). Offset-based arcs are much more accurate
 // but still have a problem when arcs are full-circles (2*pi). This define accounts for the floating
@@ -461,6 +635,15 @@
 // #define RX_BUFFER_SIZE 128 // (1-254) Uncomment to override defaults in serial.h
 // #define TX_BUFFER_SIZE 100 // (1-254)
 
+// Parses g-code lines in place in the serial receive buffer, instead of copying each character
+// through serial_read() into the line buffer. The receive interrupt removes spaces and comments,
+// capitalizes letters and counts complete lines as the characters arrive, so the main loop only
+// wakes up for whole lines. Ring space is released after a line has been executed. G-code lines
+// may then be up to RX_BUFFER_SIZE-1 characters long, after filtering, without more RAM. '$' system
+// commands are still copied into the line buffer and limited to its size.
+// NOTE: Not compatible with REPORT_ECHO_LINE_RECEIVED.
+// #define RX_BUFFER_LINE_PARSING // Default disabled. Uncomment to enable.
+
 // A simple software debouncing feature for hard limit switches. When enabled, the interrupt 
 // monitoring the hard limit switch pins will enable the Arduino's watchdog timer to re-check 
 // the limit pin state after a delay of about 32msec. This can help with CNC machines with 
@@ -77,7 +77,8 @@ void coolant_stop()
 // Main program only. Immediately sets flood coolant running state and also mist coolant, 
 // if enabled. Also sets a flag to report an update to a coolant state.
 // Called by coolant toggle override, parking restore, parking retract, sleep mode, g-code
-// parser program end, and g-code parser coolant_sync().
+// parser program end, and g-code parser coolant_sync(). With planned accessory changes, also
+// called by the stepper ISR at the start of a block.
 void coolant_set_state(uint8_t mode)
 {
   if (sys.abort) { return; } // Block during abort.  
@@ -121,6 +122,10 @@ void coolant_set_state(uint8_t mode)
 void coolant_sync(uint8_t mode)
 {
   if (sys.state == STATE_CHECK_MODE) { return; }
-  protocol_buffer_synchronize(); // Ensure coolant turns on when specified in program.
+  #ifdef PLANNED_ACCESSORY_STATE
+    if (!protocol_accessory_sync()) { return; } // Set by the stepper with the next block.
+  #else
+    protocol_buffer_synchronize(); // Ensure coolant turns on when specified in program.
+  #endif
   coolant_set_state(mode);
 }
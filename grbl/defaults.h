@@ -568,4 +568,23 @@
   #define DEFAULT_HOMING_PULLOFF 1.0 // mm
 #endif
 
+// Per-axis homing rates used by HOMING_PARALLEL_AXES. Machine defaults above may override these.
+#ifndef DEFAULT_X_HOMING_FEED_RATE
+  #define DEFAULT_X_HOMING_FEED_RATE DEFAULT_HOMING_FEED_RATE
+  #define DEFAULT_Y_HOMING_FEED_RATE DEFAULT_HOMING_FEED_RATE
+  #define DEFAULT_Z_HOMING_FEED_RATE DEFAULT_HOMING_FEED_RATE
+#endif
+#ifndef DEFAULT_X_HOMING_SEEK_RATE
+  #define DEFAULT_X_HOMING_SEEK_RATE DEFAULT_HOMING_SEEK_RATE
+  #define DEFAULT_Y_HOMING_SEEK_RATE DEFAULT_HOMING_SEEK_RATE
+  #define DEFAULT_Z_HOMING_SEEK_RATE DEFAULT_HOMING_SEEK_RATE
+#endif
+
+// Per-axis backlash used by ENABLE_BACKLASH_COMPENSATION. Zero disables compensation of the axis.
+#ifndef DEFAULT_X_BACKLASH
+  #define DEFAULT_X_BACKLASH 0.0 // mm
+  #define DEFAULT_Y_BACKLASH 0.0 // mm
+  #define DEFAULT_Z_BACKLASH 0.0 // mm
+#endif
+
 #endif
@@ -38,6 +38,145 @@ parser_block_t gc_block;
 
 #define FAIL(status) return(status);
 
+// G and M command table entry. Each supported command value, including decimal commands like
+// G38.2, maps to its modal group and the parser block field and value it assigns.
+typedef struct {
+  uint8_t code;     // Integer part of the command value
+  uint8_t mantissa; // Decimal part x100. G28.1 is 10.
+  uint8_t group;    // Modal group
+  uint8_t field;    // Byte offset of the assigned field in parser_block_t or GC_FIELD_NONE
+  uint8_t value;    // Value assigned to the field
+  uint8_t flags;    // Axis command type and GC_CMD_* flags
+} gc_command_t;
+
+#define GC_FIELD_NONE 0xff
+#define GC_FIELD(member) offsetof(parser_block_t,member)
+
+#define GC_CMD_AXIS_MASK   0x03   // AXIS_COMMAND_* type of the command
+#define GC_CMD_SET_BITS    bit(2) // Value is OR'd into the field (M7/M8)
+#define GC_CMD_NO_DECIMALS bit(3) // Other Gxx.x values of this code are unsupported, not non-integer.
+#define GC_CMD_ANY_DECIMALS bit(4) // Any Gxx.x value of this code is accepted as the integer command.
+
+#define G_MOTION(code,mantissa,value,flags) \
+  {code,mantissa,MODAL_GROUP_G1,GC_FIELD(modal.motion),value,AXIS_COMMAND_MOTION_MODE|(flags)}
+#define G_NON_MODAL(code,mantissa,value,flags) \
+  {code,mantissa,MODAL_GROUP_G0,GC_FIELD(non_modal_command),value,flags}
+
+// NOTE: Tables must be sorted by code for the binary search of the lookup.
+static const gc_command_t gc_g_commands[] PROGMEM = {
+  G_MOTION(0,0,MOTION_MODE_SEEK,0),
+  G_MOTION(1,0,MOTION_MODE_LINEAR,0),
+  G_MOTION(2,0,MOTION_MODE_CW_ARC,0),
+  G_MOTION(3,0,MOTION_MODE_CCW_ARC,0),
+  G_NON_MODAL(4,0,NON_MODAL_DWELL,0),
+  #ifdef ENABLE_G5_SPLINES
+    G_MOTION(5,0,MOTION_MODE_CUBIC_SPLINE,GC_CMD_NO_DECIMALS),
+    G_MOTION(5,10,MOTION_MODE_QUADRATIC_SPLINE,GC_CMD_NO_DECIMALS),
+  #endif
+  G_NON_MODAL(10,0,NON_MODAL_SET_COORDINATE_DATA,AXIS_COMMAND_NON_MODAL),
+  {17,0,MODAL_GROUP_G2,GC_FIELD(modal.plane_select),PLANE_SELECT_XY,0},
+  {18,0,MODAL_GROUP_G2,GC_FIELD(modal.plane_select),PLANE_SELECT_ZX,0},
+  {19,0,MODAL_GROUP_G2,GC_FIELD(modal.plane_select),PLANE_SELECT_YZ,0},
+  {20,0,MODAL_GROUP_G6,GC_FIELD(modal.units),UNITS_MODE_INCHES,0},
+  {21,0,MODAL_GROUP_G6,GC_FIELD(modal.units),UNITS_MODE_MM,0},
+  G_NON_MODAL(28,0,NON_MODAL_GO_HOME_0,AXIS_COMMAND_NON_MODAL|GC_CMD_NO_DECIMALS),
+  G_NON_MODAL(28,10,NON_MODAL_SET_HOME_0,GC_CMD_NO_DECIMALS),
+  G_NON_MODAL(30,0,NON_MODAL_GO_HOME_1,AXIS_COMMAND_NON_MODAL|GC_CMD_NO_DECIMALS),
+  G_NON_MODAL(30,10,NON_MODAL_SET_HOME_1,GC_CMD_NO_DECIMALS),
+  G_MOTION(38,20,MOTION_MODE_PROBE_TOWARD,GC_CMD_NO_DECIMALS),
+  G_MOTION(38,30,MOTION_MODE_PROBE_TOWARD_NO_ERROR,GC_CMD_NO_DECIMALS),
+  G_MOTION(38,40,MOTION_MODE_PROBE_AWAY,GC_CMD_NO_DECIMALS),
+  G_MOTION(38,50,MOTION_MODE_PROBE_AWAY_NO_ERROR,GC_CMD_NO_DECIMALS),
+  // NOTE: G40 is not tracked, since cutter radius compensation is always disabled. Only here
+  // to support G40 commands that often appear in g-code program headers to setup defaults.
+  {40,0,MODAL_GROUP_G7,GC_FIELD_NONE,CUTTER_COMP_DISABLE,0},
+  {43,10,MODAL_GROUP_G8,GC_FIELD(modal.tool_length),TOOL_LENGTH_OFFSET_ENABLE_DYNAMIC,
+    AXIS_COMMAND_TOOL_LENGTH_OFFSET|GC_CMD_NO_DECIMALS},
+  {49,0,MODAL_GROUP_G8,GC_FIELD(modal.tool_length),TOOL_LENGTH_OFFSET_CANCEL,
+    AXIS_COMMAND_TOOL_LENGTH_OFFSET|GC_CMD_ANY_DECIMALS}, // G49.x is G49.
+  G_NON_MODAL(53,0,NON_MODAL_ABSOLUTE_OVERRIDE,0),
+  // NOTE: G59.x are not supported.
+  {54,0,MODAL_GROUP_G12,GC_FIELD(modal.coord_select),0,0},
+  {55,0,MODAL_GROUP_G12,GC_FIELD(modal.coord_select),1,0},
+  {56,0,MODAL_GROUP_G12,GC_FIELD(modal.coord_select),2,0},
+  {57,0,MODAL_GROUP_G12,GC_FIELD(modal.coord_select),3,0},
+  {58,0,MODAL_GROUP_G12,GC_FIELD(modal.coord_select),4,0},
+  {59,0,MODAL_GROUP_G12,GC_FIELD(modal.coord_select),5,0},
+  {61,0,MODAL_GROUP_G13,GC_FIELD_NONE,CONTROL_MODE_EXACT_PATH,GC_CMD_NO_DECIMALS}, // G61.1 not supported
+  #ifdef ENABLE_CANNED_CYCLES
+    G_MOTION(73,0,MOTION_MODE_CHIP_BREAK_DRILL,0),
+  #endif
+  {80,0,MODAL_GROUP_G1,GC_FIELD(modal.motion),MOTION_MODE_NONE,0},
+  #ifdef ENABLE_CANNED_CYCLES
+    G_MOTION(81,0,MOTION_MODE_DRILL,0),
+    G_MOTION(82,0,MOTION_MODE_DWELL_DRILL,0),
+    G_MOTION(83,0,MOTION_MODE_PECK_DRILL,0),
+  #endif
+  {90,0,MODAL_GROUP_G3,GC_FIELD(modal.distance),DISTANCE_MODE_ABSOLUTE,GC_CMD_NO_DECIMALS}, // G90.1 not supported
+  {91,0,MODAL_GROUP_G3,GC_FIELD(modal.distance),DISTANCE_MODE_INCREMENTAL,GC_CMD_NO_DECIMALS},
+  // NOTE: Arc IJK incremental mode is default. G91.1 does nothing.
+  {91,10,MODAL_GROUP_G4,GC_FIELD_NONE,DISTANCE_ARC_MODE_INCREMENTAL,GC_CMD_NO_DECIMALS},
+  G_NON_MODAL(92,0,NON_MODAL_SET_COORDINATE_OFFSET,AXIS_COMMAND_NON_MODAL|GC_CMD_NO_DECIMALS),
+  G_NON_MODAL(92,10,NON_MODAL_RESET_COORDINATE_OFFSET,GC_CMD_NO_DECIMALS),
+  {93,0,MODAL_GROUP_G5,GC_FIELD(modal.feed_rate),FEED_RATE_MODE_INVERSE_TIME,0},
+  {94,0,MODAL_GROUP_G5,GC_FIELD(modal.feed_rate),FEED_RATE_MODE_UNITS_PER_MIN,0},
+  #ifdef ENABLE_CANNED_CYCLES
+    {98,0,MODAL_GROUP_G10,GC_FIELD(modal.retract),RETRACT_MODE_INITIAL,0},
+    {99,0,MODAL_GROUP_G10,GC_FIELD(modal.retract),RETRACT_MODE_R_PLANE,0},
+  #endif
+};
+#define N_G_COMMANDS (sizeof(gc_g_commands)/sizeof(gc_command_t))
+
+static const gc_command_t gc_m_commands[] PROGMEM = {
+  {0,0,MODAL_GROUP_M4,GC_FIELD(modal.program_flow),PROGRAM_FLOW_PAUSED,0},
+  {1,0,MODAL_GROUP_M4,GC_FIELD_NONE,PROGRAM_FLOW_OPTIONAL_STOP,0}, // Optional stop not supported. Ignore.
+  {2,0,MODAL_GROUP_M4,GC_FIELD(modal.program_flow),PROGRAM_FLOW_COMPLETED_M2,0},
+  {3,0,MODAL_GROUP_M7,GC_FIELD(modal.spindle),SPINDLE_ENABLE_CW,0},
+  {4,0,MODAL_GROUP_M7,GC_FIELD(modal.spindle),SPINDLE_ENABLE_CCW,0},
+  {5,0,MODAL_GROUP_M7,GC_FIELD(modal.spindle),SPINDLE_DISABLE,0},
+  #ifdef ENABLE_M7
+    {7,0,MODAL_GROUP_M8,GC_FIELD(modal.coolant),COOLANT_MIST_ENABLE,GC_CMD_SET_BITS},
+  #endif
+  {8,0,MODAL_GROUP_M8,GC_FIELD(modal.coolant),COOLANT_FLOOD_ENABLE,GC_CMD_SET_BITS},
+  {9,0,MODAL_GROUP_M8,GC_FIELD(modal.coolant),COOLANT_DISABLE,0}, // M9 disables both M7 and M8.
+  {30,0,MODAL_GROUP_M4,GC_FIELD(modal.program_flow),PROGRAM_FLOW_COMPLETED_M30,0},
+  #ifdef ENABLE_PARKING_OVERRIDE_CONTROL
+    {56,0,MODAL_GROUP_M9,GC_FIELD(modal.override),OVERRIDE_PARKING_MOTION,0},
+  #endif
+};
+#define N_M_COMMANDS (sizeof(gc_m_commands)/sizeof(gc_command_t))
+
+
+// Finds a command value in a G or M command table and copies its entry from flash. Returns an
+// unsupported command error, if the code is missing or its decimal value is not a valid command.
+// For an invalid decimal value, the last entry of the code is left in command, so its axis command
+// type is still checked for conflicts. Otherwise, the flags are cleared.
+// NOTE: Binary searches the sorted codes, reading only the code byte, so a lookup takes at most six
+// flash reads up to the first entry of the code. Only entries of the code are copied.
+static uint8_t gc_find_command(const gc_command_t *table, uint8_t n_commands, uint8_t int_value,
+                               uint16_t mantissa, gc_command_t *command)
+{
+  uint8_t idx = 0;
+  uint8_t idx_end = n_commands;
+  uint8_t idx_mid;
+  while (idx < idx_end) {
+    idx_mid = (idx+idx_end) >> 1;
+    if (pgm_read_byte(&table[idx_mid].code) < int_value) { idx = idx_mid+1; }
+    else { idx_end = idx_mid; }
+  }
+  uint8_t status = STATUS_GCODE_UNSUPPORTED_COMMAND;
+  command->flags = 0;
+  for (; idx<n_commands; idx++) {
+    if (pgm_read_byte(&table[idx].code) != int_value) { break; }
+    memcpy_P(command,&table[idx],sizeof(gc_command_t));
+    if ((command->mantissa == mantissa) || (command->flags & GC_CMD_ANY_DECIMALS)) { return(STATUS_OK); }
+    // Known code with an invalid decimal value, e.g. G4.5 or G38.1.
+    if (command->flags & GC_CMD_NO_DECIMALS) { status = STATUS_GCODE_UNSUPPORTED_COMMAND; }
+    else { status = STATUS_GCODE_COMMAND_VALUE_NOT_INTEGER; }
+  }
+  return(status);
+}
+
 
 void gc_init()
 {
@@ -55,16 +194,117 @@ void gc_init()
 void gc_sync_position()
 {
   system_convert_array_steps_to_mpos(gc_state.position,sys_position);
+  #ifdef ENABLE_MESH_LEVELING
+    mesh_remove_offset(gc_state.position); // Parser positions are uncompensated.
+  #endif
 }
 
 
-// Executes one line of 0-terminated G-Code. The line is assumed to contain only uppercase
-// characters and signed floating point values (no whitespace). Comments and block delete
-// characters have been removed. In this function, all units and positions are converted and
-// exported to grbl's internal functions in terms of (mm, mm/min) and absolute machine
-// coordinates, respectively.
-uint8_t gc_execute_line(char *line)
+#ifdef AXIS_LINE_FAST_PATH
+  // Executes a line of only X, Y, Z, F and N words in G0 or G1 with G94 active. Returns false,
+  // without changing any state, if the line has any other word or would fail an error check. The
+  // full parser then executes the line and reports any error. Otherwise, the parser state and the
+  // queued motion are the same as those of the full parser.
+  static uint8_t gc_execute_axis_line(char *line, uint8_t char_counter)
+  {
+    if ((gc_state.modal.motion != MOTION_MODE_SEEK) && (gc_state.modal.motion != MOTION_MODE_LINEAR)) { return(false); }
+    if (gc_state.modal.feed_rate != FEED_RATE_MODE_UNITS_PER_MIN) { return(false); }
+
+    float target[N_AXIS];
+    float feed_rate = gc_state.feed_rate;
+    float value;
+    int32_t line_number = 0;
+    uint8_t axis_words = 0;
+    uint8_t value_words = 0;
+    uint8_t idx;
+    char letter;
+    while (line[char_counter] != 0) {
+      letter = line[char_counter];
+      line_advance(char_counter);
+      if (!read_float(line, &char_counter, &value)) { return(false); }
+      switch (letter) {
+        case 'X': idx = X_AXIS; break;
+        case 'Y': idx = Y_AXIS; break;
+        case 'Z': idx = Z_AXIS; break;
+        case 'F':
+          if (bit_istrue(value_words,bit(WORD_F)) || (value < 0.0)) { return(false); }
+          value_words |= bit(WORD_F);
+          feed_rate = value;
+          if (gc_state.modal.units == UNITS_MODE_INCHES) { feed_rate *= MM_PER_INCH; }
+          continue;
+        case 'N':
+          if (bit_istrue(value_words,bit(WORD_N)) || (value < 0.0)) { return(false); }
+          value_words |= bit(WORD_N);
+          line_number = trunc(value);
+          if (line_number > MAX_LINE_NUMBER) { return(false); }
+          continue;
+        default: return(false);
+      }
+      if (bit_istrue(axis_words,bit(idx))) { return(false); }
+      axis_words |= bit(idx);
+      target[idx] = value;
+    }
+    if (!axis_words) { return(false); }
+    if ((gc_state.modal.motion == MOTION_MODE_LINEAR) && (feed_rate == 0.0)) { return(false); }
+
+    // Convert to an absolute machine target in mm, in the same order of operations as STEP 3.
+    for (idx=0; idx<N_AXIS; idx++) {
+      if (bit_isfalse(axis_words,bit(idx))) {
+        target[idx] = gc_state.position[idx];
+      } else {
+        if (gc_state.modal.units == UNITS_MODE_INCHES) { target[idx] *= MM_PER_INCH; }
+        if (gc_state.modal.distance == DISTANCE_MODE_ABSOLUTE) {
+          target[idx] += gc_state.coord_system[idx] + gc_state.coord_offset[idx];
+          if (idx == TOOL_LENGTH_OFFSET_AXIS) { target[idx] += gc_state.tool_length_offset; }
+        } else {
+          target[idx] += gc_state.position[idx];
+        }
+      }
+    }
+
+    plan_line_data_t plan_data;
+    plan_line_data_t *pl_data = &plan_data;
+    memset(pl_data,0,sizeof(plan_line_data_t));
+    gc_state.line_number = line_number;
+    #ifdef USE_LINE_NUMBERS
+      pl_data->line_number = line_number;
+    #endif
+    gc_state.feed_rate = feed_rate;
+    pl_data->feed_rate = feed_rate;
+    // NOTE: The spindle state is unchanged, so no sync is needed. G0 passes zero speed in laser mode.
+    if (bit_isfalse(settings.flags,BITFLAG_LASER_MODE) || (gc_state.modal.motion == MOTION_MODE_LINEAR)) {
+      pl_data->spindle_speed = gc_state.spindle_speed;
+    }
+    gc_state.tool = 0; // The full parser sets the tool of every block without a T word to zero.
+    pl_data->condition = (gc_state.modal.spindle | gc_state.modal.coolant);
+
+    if (gc_state.modal.motion == MOTION_MODE_LINEAR) {
+      mc_line(target, pl_data);
+    } else {
+      pl_data->condition |= PL_COND_FLAG_RAPID_MOTION;
+      #ifdef INDEPENDENT_AXIS_RAPIDS
+        mc_rapid(target, pl_data, gc_state.position);
+      #else
+        mc_line(target, pl_data);
+      #endif
+    }
+    memcpy(gc_state.position, target, sizeof(target));
+    return(true);
+  }
+#endif
+
+
+// Executes one line of 0-terminated G-Code, starting at index char_counter of line. The line is
+// assumed to contain only uppercase characters and signed floating point values (no whitespace).
+// Comments and block delete characters have been removed. In this function, all units and
+// positions are converted and exported to grbl's internal functions in terms of (mm, mm/min) and
+// absolute machine coordinates, respectively.
+uint8_t gc_execute_line(char *line, uint8_t char_counter)
 {
+  #ifdef AXIS_LINE_FAST_PATH
+    if (gc_execute_axis_line(line, char_counter)) { return(STATUS_OK); }
+  #endif
+
   /* -------------------------------------------------------------------------------------
      STEP 1: Initialize parser block struct and copy current g-code state modes. The parser
      updates these modes and commands as the block line is parser and will only be used and
@@ -78,6 +318,9 @@ uint8_t gc_execute_line(char *line)
   uint8_t axis_command = AXIS_COMMAND_NONE;
   uint8_t axis_0, axis_1, axis_linear;
   uint8_t coord_select = 0; // Tracks G10 P coordinate selection for execution
+  #ifdef ENABLE_CANNED_CYCLES
+    mc_cycle_data_t cycle_data; // Canned cycle parameters. Computed during error-checking.
+  #endif
 
   // Initialize bitflag tracking variables for axis indices compatible operations.
   uint8_t axis_words = 0; // XYZ tracking
@@ -89,7 +332,7 @@ uint8_t gc_execute_line(char *line)
   uint8_t gc_parser_flags = GC_PARSER_NONE;
 
   // Determine if the line is a jogging motion or a normal g-code block.
-  if (line[0] == '$') { // NOTE: `$J=` already parsed when passed to this function.
+  if (line[char_counter] == '$') { // NOTE: `$J=` already parsed when passed to this function.
     // Set G1 and G94 enforced modes to ensure accurate error checks.
     gc_parser_flags |= GC_PARSER_JOG_MOTION;
     gc_block.modal.motion = MOTION_MODE_LINEAR;
@@ -106,20 +349,20 @@ uint8_t gc_execute_line(char *line)
      words, and for negative values set for the value words F, N, P, T, and S. */
 
   uint8_t word_bit; // Bit-value for assigning tracking variables
-  uint8_t char_counter;
+  gc_command_t command; // G/M command table entry
+  uint8_t command_status;
   char letter;
   float value;
   uint8_t int_value = 0;
   uint16_t mantissa = 0;
-  if (gc_parser_flags & GC_PARSER_JOG_MOTION) { char_counter = 3; } // Start parsing after `$J=`
-  else { char_counter = 0; }
+  if (gc_parser_flags & GC_PARSER_JOG_MOTION) { char_counter += 3; } // Start parsing after `$J=`
 
   while (line[char_counter] != 0) { // Loop until no more g-code words in line.
 
     // Import the next g-code word, expecting a letter followed by a value. Otherwise, error out.
     letter = line[char_counter];
     if((letter < 'A') || (letter > 'Z')) { FAIL(STATUS_EXPECTED_COMMAND_LETTER); } // [Expected word letter]
-    char_counter++;
+    line_advance(char_counter);
     if (!read_float(line, &char_counter, &value)) { FAIL(STATUS_BAD_NUMBER_FORMAT); } // [Expected word value]
 
     // Convert values to smaller uint8 significand and mantissa values for parsing this word.
@@ -140,153 +383,37 @@ uint8_t gc_execute_line(char *line)
       /* 'G' and 'M' Command Words: Parse commands and check for modal group violations.
          NOTE: Modal group numbers are defined in Table 4 of NIST RS274-NGC v3, pg.20 */
 
-      case 'G':
-        // Determine 'G' command and its modal group
-        switch(int_value) {
-          case 10: case 28: case 30: case 92:
-            // Check for G10/28/30/92 being called with G0/1/2/3/38 on same block.
-            // * G43.1 is also an axis command but is not explicitly defined this way.
-            if (mantissa == 0) { // Ignore G28.1, G30.1, and G92.1
-              if (axis_command) { FAIL(STATUS_GCODE_AXIS_COMMAND_CONFLICT); } // [Axis word/command conflict]
-              axis_command = AXIS_COMMAND_NON_MODAL;
-            }
-            // No break. Continues to next line.
-            // Fall-through
-          case 4: case 53:
-            word_bit = MODAL_GROUP_G0;
-            gc_block.non_modal_command = int_value;
-            if ((int_value == 28) || (int_value == 30) || (int_value == 92)) {
-              if (!((mantissa == 0) || (mantissa == 10))) { FAIL(STATUS_GCODE_UNSUPPORTED_COMMAND); }
-              gc_block.non_modal_command += mantissa;
-              mantissa = 0; // Set to zero to indicate valid non-integer G command.
-            }                
-            break;
-          case 0: case 1: case 2: case 3: case 38:
-            // Check for G0/1/2/3/38 being called with G10/28/30/92 on same block.
-            // * G43.1 is also an axis command but is not explicitly defined this way.
-            if (axis_command) { FAIL(STATUS_GCODE_AXIS_COMMAND_CONFLICT); } // [Axis word/command conflict]
-            axis_command = AXIS_COMMAND_MOTION_MODE;
-            // No break. Continues to next line.
-            // Fall-through
-          case 80:
-            word_bit = MODAL_GROUP_G1;
-            gc_block.modal.motion = int_value;
-            if (int_value == 38){
-              if (!((mantissa == 20) || (mantissa == 30) || (mantissa == 40) || (mantissa == 50))) {
-                FAIL(STATUS_GCODE_UNSUPPORTED_COMMAND); // [Unsupported G38.x command]
-              }
-              gc_block.modal.motion += (mantissa/10)+100;
-              mantissa = 0; // Set to zero to indicate valid non-integer G command.
-            }  
-            break;
-          case 17: case 18: case 19:
-            word_bit = MODAL_GROUP_G2;
-            gc_block.modal.plane_select = int_value - 17;
-            break;
-          case 90: case 91:
-            if (mantissa == 0) {
-              word_bit = MODAL_GROUP_G3;
-              gc_block.modal.distance = int_value - 90;
-            } else {
-              word_bit = MODAL_GROUP_G4;
-              if ((mantissa != 10) || (int_value == 90)) { FAIL(STATUS_GCODE_UNSUPPORTED_COMMAND); } // [G90.1 not supported]
-              mantissa = 0; // Set to zero to indicate valid non-integer G command.
-              // Otherwise, arc IJK incremental mode is default. G91.1 does nothing.
-            }
-            break;
-          case 93: case 94:
-            word_bit = MODAL_GROUP_G5;
-            gc_block.modal.feed_rate = 94 - int_value;
-            break;
-          case 20: case 21:
-            word_bit = MODAL_GROUP_G6;
-            gc_block.modal.units = 21 - int_value;
-            break;
-          case 40:
-            word_bit = MODAL_GROUP_G7;
-            // NOTE: Not required since cutter radius compensation is always disabled. Only here
-            // to support G40 commands that often appear in g-code program headers to setup defaults.
-            // gc_block.modal.cutter_comp = CUTTER_COMP_DISABLE; // G40
-            break;
-          case 43: case 49:
-            word_bit = MODAL_GROUP_G8;
-            // NOTE: The NIST g-code standard vaguely states that when a tool length offset is changed,
-            // there cannot be any axis motion or coordinate offsets updated. Meaning G43, G43.1, and G49
-            // all are explicit axis commands, regardless if they require axis words or not.
-            if (axis_command) { FAIL(STATUS_GCODE_AXIS_COMMAND_CONFLICT); } // [Axis word/command conflict] }
-            axis_command = AXIS_COMMAND_TOOL_LENGTH_OFFSET;
-            if (int_value == 49) { // G49
-              gc_block.modal.tool_length = TOOL_LENGTH_OFFSET_CANCEL;
-            } else if (mantissa == 10) { // G43.1
-              gc_block.modal.tool_length = TOOL_LENGTH_OFFSET_ENABLE_DYNAMIC;
-            } else { FAIL(STATUS_GCODE_UNSUPPORTED_COMMAND); } // [Unsupported G43.x command]
-            mantissa = 0; // Set to zero to indicate valid non-integer G command.
-            break;
-          case 54: case 55: case 56: case 57: case 58: case 59:
-            // NOTE: G59.x are not supported. (But their int_values would be 60, 61, and 62.)
-            word_bit = MODAL_GROUP_G12;
-            gc_block.modal.coord_select = int_value - 54; // Shift to array indexing.
-            break;
-          case 61:
-            word_bit = MODAL_GROUP_G13;
-            if (mantissa != 0) { FAIL(STATUS_GCODE_UNSUPPORTED_COMMAND); } // [G61.1 not supported]
-            // gc_block.modal.control = CONTROL_MODE_EXACT_PATH; // G61
-            break;
-          default: FAIL(STATUS_GCODE_UNSUPPORTED_COMMAND); // [Unsupported G command]
+      case 'G': case 'M':
+        // Look up the command in its table. Decimal commands (G28.1, G38.2, etc) are separate
+        // entries, so the lookup also rejects unsupported or non-integer command values.
+        if (letter == 'G') {
+          command_status = gc_find_command(gc_g_commands, N_G_COMMANDS, int_value, mantissa, &command);
+        } else {
+          if (mantissa > 0) { FAIL(STATUS_GCODE_COMMAND_VALUE_NOT_INTEGER); } // [No Mxx.x commands]
+          command_status = gc_find_command(gc_m_commands, N_M_COMMANDS, int_value, mantissa, &command);
         }
-        if (mantissa > 0) { FAIL(STATUS_GCODE_COMMAND_VALUE_NOT_INTEGER); } // [Unsupported or invalid Gxx.x command]
-        // Check for more than one command per modal group violations in the current block
-        // NOTE: Variable 'word_bit' is always assigned, if the command is valid.
-        if ( bit_istrue(command_words,bit(word_bit)) ) { FAIL(STATUS_GCODE_MODAL_GROUP_VIOLATION); }
-        command_words |= bit(word_bit);
-        break;
 
-      case 'M':
-
-        // Determine 'M' command and its modal group
-        if (mantissa > 0) { FAIL(STATUS_GCODE_COMMAND_VALUE_NOT_INTEGER); } // [No Mxx.x commands]
-        switch(int_value) {
-          case 0: case 1: case 2: case 30:
-            word_bit = MODAL_GROUP_M4;
-            switch(int_value) {
-              case 0: gc_block.modal.program_flow = PROGRAM_FLOW_PAUSED; break; // Program pause
-              case 1: break; // Optional stop not supported. Ignore.
-              default: gc_block.modal.program_flow = int_value; // Program end and reset
-            }
-            break;
-          case 3: case 4: case 5:
-            word_bit = MODAL_GROUP_M7;
-            switch(int_value) {
-              case 3: gc_block.modal.spindle = SPINDLE_ENABLE_CW; break;
-              case 4: gc_block.modal.spindle = SPINDLE_ENABLE_CCW; break;
-              case 5: gc_block.modal.spindle = SPINDLE_DISABLE; break;
-            }
-            break;
-          #ifdef ENABLE_M7
-            case 7: case 8: case 9:
-          #else
-            case 8: case 9:
-          #endif
-            word_bit = MODAL_GROUP_M8;
-            switch(int_value) {
-              #ifdef ENABLE_M7
-                case 7: gc_block.modal.coolant |= COOLANT_MIST_ENABLE; break;
-              #endif
-              case 8: gc_block.modal.coolant |= COOLANT_FLOOD_ENABLE; break;
-              case 9: gc_block.modal.coolant = COOLANT_DISABLE; break; // M9 disables both M7 and M8.
-            }
-            break;
-          #ifdef ENABLE_PARKING_OVERRIDE_CONTROL
-            case 56:
-              word_bit = MODAL_GROUP_M9;
-              gc_block.modal.override = OVERRIDE_PARKING_MOTION;
-              break;
-          #endif
-          default: FAIL(STATUS_GCODE_UNSUPPORTED_COMMAND); // [Unsupported M command]
+        // Check for axis commands (G0/1/2/3/5/38, G10/28/30/92, G43.1/49) on the same block.
+        // NOTE: The NIST g-code standard vaguely states that when a tool length offset is changed,
+        // there cannot be any axis motion or coordinate offsets updated. Meaning G43.1 and G49
+        // are both explicit axis commands, regardless if they require axis words or not.
+        // Motion and tool length codes conflict before their decimal value is checked, e.g. G1 G43.
+        // G10/28/30/92 only do with a valid value, so G28.1 may follow a motion command.
+        word_bit = command.flags & GC_CMD_AXIS_MASK; // Axis command type
+        if (word_bit && ((command_status == STATUS_OK) || (word_bit != AXIS_COMMAND_NON_MODAL))) {
+          if (axis_command) { FAIL(STATUS_GCODE_AXIS_COMMAND_CONFLICT); } // [Axis word/command conflict]
+          axis_command = word_bit;
+        }
+        if (command_status != STATUS_OK) { FAIL(command_status); } // [Unsupported or invalid G/M command]
+        // Assign the command value. G40, G61, G91.1 and M1 are valid defaults and do nothing.
+        if (command.field != GC_FIELD_NONE) {
+          uint8_t *field = (uint8_t*)&gc_block + command.field;
+          if (command.flags & GC_CMD_SET_BITS) { *field |= command.value; } // M7/M8 combine.
+          else { *field = command.value; }
         }
 
         // Check for more than one command per modal group violations in the current block
-        // NOTE: Variable 'word_bit' is always assigned, if the command is valid.
+        word_bit = command.group;
         if ( bit_istrue(command_words,bit(word_bit)) ) { FAIL(STATUS_GCODE_MODAL_GROUP_VIOLATION); }
         command_words |= bit(word_bit);
         break;
@@ -311,7 +438,11 @@ uint8_t gc_execute_line(char *line)
           case 'N': word_bit = WORD_N; gc_block.values.n = trunc(value); break;
           case 'P': word_bit = WORD_P; gc_block.values.p = value; break;
           // NOTE: For certain commands, P value must be an integer, but none of these commands are supported.
-          // case 'Q': // Not supported
+          #if defined(ENABLE_G5_SPLINES) || defined(ENABLE_CANNED_CYCLES)
+            case 'Q': word_bit = WORD_Q; gc_block.values.q = value; break;
+          #else
+            // case 'Q': // Not supported
+          #endif
           case 'R': word_bit = WORD_R; gc_block.values.r = value; break;
           case 'S': word_bit = WORD_S; gc_block.values.s = value; break;
           case 'T': word_bit = WORD_T; 
@@ -328,7 +459,12 @@ uint8_t gc_execute_line(char *line)
         if (bit_istrue(value_words,bit(word_bit))) { FAIL(STATUS_GCODE_WORD_REPEATED); } // [Word repeated]
         // Check for invalid negative values for words F, N, P, T, and S.
         // NOTE: Negative value check is done here simply for code-efficiency.
-        if ( bit(word_bit) & (bit(WORD_F)|bit(WORD_N)|bit(WORD_P)|bit(WORD_T)|bit(WORD_S)) ) {
+        #ifdef ENABLE_G5_SPLINES
+          // P is a signed control point offset for G5. Its check is deferred until the motion is known.
+          if ( bit(word_bit) & (bit(WORD_F)|bit(WORD_N)|bit(WORD_T)|bit(WORD_S)) ) {
+        #else
+          if ( bit(word_bit) & (bit(WORD_F)|bit(WORD_N)|bit(WORD_P)|bit(WORD_T)|bit(WORD_S)) ) {
+        #endif
           if (value < 0.0) { FAIL(STATUS_NEGATIVE_VALUE); } // [Word value cannot be negative]
         }
         value_words |= bit(word_bit); // Flag to indicate parameter assigned.
@@ -372,6 +508,15 @@ uint8_t gc_execute_line(char *line)
     if (!axis_command) { axis_command = AXIS_COMMAND_MOTION_MODE; } // Assign implicit motion-mode
   }
 
+  #ifdef ENABLE_G5_SPLINES
+    // Complete the P word negative value check, except for G5 motions.
+    if (gc_block.values.p < 0.0) {
+      if ((gc_block.modal.motion != MOTION_MODE_CUBIC_SPLINE) || (axis_command != AXIS_COMMAND_MOTION_MODE)) {
+        FAIL(STATUS_NEGATIVE_VALUE); // [Word value cannot be negative]
+      }
+    }
+  #endif
+
   // Check for valid line number N value.
   if (bit_istrue(value_words,bit(WORD_N))) {
     // Line number value cannot be less than zero (done) or greater than max line number.
@@ -514,7 +659,7 @@ uint8_t gc_execute_line(char *line)
 
   // [16. Set path control mode ]: N/A. Only G61. G61.1 and G64 NOT SUPPORTED.
   // [17. Set distance mode ]: N/A. Only G91.1. G90.1 NOT SUPPORTED.
-  // [18. Set retract mode ]: NOT SUPPORTED.
+  // [18. Set retract mode ]: N/A. G98/G99 are a compile-option for canned cycles.
 
   // [19. Remaining non-modal actions ]: Check go to predefined position, set G10, or set axis offsets.
   // NOTE: We need to separate the non-modal commands that are axis word-using (G10/G28/G30/G92), as these
@@ -822,6 +967,101 @@ uint8_t gc_execute_line(char *line)
           if (!axis_words) { FAIL(STATUS_GCODE_NO_AXIS_WORDS); } // [No axis words]
           if (isequal_position_vector(gc_state.position, gc_block.values.xyz)) { FAIL(STATUS_GCODE_INVALID_TARGET); } // [Invalid target]
           break;
+        #ifdef ENABLE_G5_SPLINES
+          case MOTION_MODE_CUBIC_SPLINE: case MOTION_MODE_QUADRATIC_SPLINE:
+            // [G5/G5.1 Errors]: Plane is not G17. Z axis word. Only one of I or J. G5: P or Q missing. I and J
+            //   missing, but not following a G5. G5.1: I and J missing, or P or Q passed (unused words).
+            // NOTE: Both splines are converted to a cubic with first control point offset from the current
+            // position in IJ and second control point offset from the target in PQ.
+            if (gc_block.modal.plane_select != PLANE_SELECT_XY) { FAIL(STATUS_GCODE_UNSUPPORTED_COMMAND); } // [Plane not G17]
+            if (axis_words & bit(Z_AXIS)) { FAIL(STATUS_GCODE_UNSUPPORTED_COMMAND); } // [No helical splines]
+            if (gc_block.modal.units == UNITS_MODE_INCHES) {
+              gc_block.values.ijk[X_AXIS] *= MM_PER_INCH;
+              gc_block.values.ijk[Y_AXIS] *= MM_PER_INCH;
+              gc_block.values.p *= MM_PER_INCH;
+              gc_block.values.q *= MM_PER_INCH;
+            }
+            if ((ijk_words & (bit(X_AXIS)|bit(Y_AXIS))) != (bit(X_AXIS)|bit(Y_AXIS))) {
+              if (ijk_words & (bit(X_AXIS)|bit(Y_AXIS))) { FAIL(STATUS_GCODE_VALUE_WORD_MISSING); } // [Only one of I or J]
+              // Continue a G5 series by reflecting the last second control point about the current position.
+              if ((gc_block.modal.motion != MOTION_MODE_CUBIC_SPLINE) || (gc_state.modal.motion != MOTION_MODE_CUBIC_SPLINE)) {
+                FAIL(STATUS_GCODE_VALUE_WORD_MISSING); // [I and J missing]
+              }
+              gc_block.values.ijk[X_AXIS] = -gc_state.spline_control[X_AXIS];
+              gc_block.values.ijk[Y_AXIS] = -gc_state.spline_control[Y_AXIS];
+            }
+            bit_false(value_words,(bit(WORD_I)|bit(WORD_J)));
+            if (gc_block.modal.motion == MOTION_MODE_CUBIC_SPLINE) {
+              if ((value_words & (bit(WORD_P)|bit(WORD_Q))) != (bit(WORD_P)|bit(WORD_Q))) { FAIL(STATUS_GCODE_VALUE_WORD_MISSING); } // [P or Q missing]
+              bit_false(value_words,(bit(WORD_P)|bit(WORD_Q)));
+            } else {
+              // Degree elevation of the quadratic control point Q1 at offset IJ: C1 = P0 + 2/3*(Q1-P0) and
+              // C2 = P3 + 2/3*(Q1-P3).
+              gc_block.values.p = 0.6666667*(gc_state.position[X_AXIS]+gc_block.values.ijk[X_AXIS]-gc_block.values.xyz[X_AXIS]);
+              gc_block.values.q = 0.6666667*(gc_state.position[Y_AXIS]+gc_block.values.ijk[Y_AXIS]-gc_block.values.xyz[Y_AXIS]);
+              gc_block.values.ijk[X_AXIS] *= 0.6666667;
+              gc_block.values.ijk[Y_AXIS] *= 0.6666667;
+            }
+            break;
+        #endif
+        #ifdef ENABLE_CANNED_CYCLES
+          case MOTION_MODE_CHIP_BREAK_DRILL: case MOTION_MODE_DRILL: case MOTION_MODE_DWELL_DRILL: case MOTION_MODE_PECK_DRILL:
+            // [G73/G81-G83 Errors]: Plane is not G17. Inverse time mode. Z or R missing at the start of a
+            //   cycle. R plane below the hole bottom. L is zero. G73/G83: Q missing or not positive.
+            // NOTE: Z, R, P and Q are retained for the following holes of a cycle. In G91, R is relative
+            // to the current Z and Z is relative to the R plane, as with LinuxCNC. The programmed Z and the
+            // initial Z of the cycle are stored in the unused IJK values for execution.
+            if (gc_block.modal.plane_select != PLANE_SELECT_XY) { FAIL(STATUS_GCODE_UNSUPPORTED_COMMAND); } // [Plane not G17]
+            if (gc_block.modal.feed_rate == FEED_RATE_MODE_INVERSE_TIME) { FAIL(STATUS_GCODE_UNSUPPORTED_COMMAND); } // [G93 cycle]
+            float cycle_base = gc_state.position[Z_AXIS];
+            if (gc_block.modal.distance == DISTANCE_MODE_ABSOLUTE) {
+              cycle_base = block_coord_system[Z_AXIS] + gc_state.coord_offset[Z_AXIS];
+              if (TOOL_LENGTH_OFFSET_AXIS == Z_AXIS) { cycle_base += gc_state.tool_length_offset; }
+            }
+            if (gc_block.modal.units == UNITS_MODE_INCHES) {
+              gc_block.values.r *= MM_PER_INCH;
+              gc_block.values.q *= MM_PER_INCH;
+            }
+            if (gc_is_canned_cycle(gc_state.modal.motion)) {
+              // Continuing a cycle. Push the retained words not in the block.
+              gc_block.values.ijk[Z_AXIS] = gc_state.cycle_z;
+              gc_block.values.ijk[X_AXIS] = gc_state.cycle_initial_z;
+              if (bit_isfalse(value_words,bit(WORD_R))) { gc_block.values.r = gc_state.cycle_r; }
+              if (bit_isfalse(value_words,bit(WORD_Q))) { gc_block.values.q = gc_state.cycle_q; }
+              if (bit_isfalse(value_words,bit(WORD_P))) { gc_block.values.p = gc_state.cycle_p; }
+            } else {
+              if (bit_isfalse(axis_words,bit(Z_AXIS)) || bit_isfalse(value_words,bit(WORD_R))) {
+                FAIL(STATUS_GCODE_VALUE_WORD_MISSING); // [Z or R word missing]
+              }
+              gc_block.values.ijk[X_AXIS] = gc_state.position[Z_AXIS];
+            }
+            if (axis_words & bit(Z_AXIS)) { gc_block.values.ijk[Z_AXIS] = gc_block.values.xyz[Z_AXIS]-cycle_base; }
+            if (value_words & bit(WORD_L)) {
+              if (gc_block.values.l == 0) { FAIL(STATUS_GCODE_UNSUPPORTED_COMMAND); } // [L is zero]
+            } else {
+              gc_block.values.l = 1;
+            }
+            bit_false(value_words,(bit(WORD_R)|bit(WORD_Q)|bit(WORD_P)|bit(WORD_L)));
+            if (gc_block.values.q < 0.0) { FAIL(STATUS_NEGATIVE_VALUE); } // [Q is negative]
+            if ((gc_block.modal.motion == MOTION_MODE_PECK_DRILL) || (gc_block.modal.motion == MOTION_MODE_CHIP_BREAK_DRILL)) {
+              if (gc_block.values.q == 0.0) { FAIL(STATUS_GCODE_VALUE_WORD_MISSING); } // [Q word missing]
+            }
+
+            cycle_data.cycle = gc_block.modal.motion;
+            cycle_data.r_plane = gc_block.values.r + cycle_base;
+            if (gc_block.modal.distance == DISTANCE_MODE_ABSOLUTE) { cycle_data.bottom = gc_block.values.ijk[Z_AXIS] + cycle_base; }
+            else { cycle_data.bottom = gc_block.values.ijk[Z_AXIS] + cycle_data.r_plane; }
+            if (cycle_data.bottom > cycle_data.r_plane) { FAIL(STATUS_GCODE_INVALID_TARGET); } // [R plane below bottom]
+            cycle_data.clear = cycle_data.r_plane;
+            if (gc_block.modal.retract == RETRACT_MODE_INITIAL) {
+              if (gc_block.values.ijk[X_AXIS] > cycle_data.clear) { cycle_data.clear = gc_block.values.ijk[X_AXIS]; }
+            }
+            cycle_data.peck = gc_block.values.q;
+            cycle_data.dwell = gc_block.values.p;
+            cycle_data.repeats = gc_block.values.l;
+            cycle_data.incremental = gc_block.modal.distance;
+            break;
+        #endif
       }
     }
   }
@@ -871,8 +1111,14 @@ uint8_t gc_execute_line(char *line)
   
   // If in laser mode, setup laser power based on current and past parser conditions.
   if (bit_istrue(settings.flags,BITFLAG_LASER_MODE)) {
+    #ifdef ENABLE_G5_SPLINES
+    if ( !((gc_block.modal.motion == MOTION_MODE_LINEAR) || (gc_block.modal.motion == MOTION_MODE_CW_ARC) 
+        || (gc_block.modal.motion == MOTION_MODE_CCW_ARC) || (gc_block.modal.motion == MOTION_MODE_CUBIC_SPLINE)
+        || (gc_block.modal.motion == MOTION_MODE_QUADRATIC_SPLINE)) ) {
+    #else
     if ( !((gc_block.modal.motion == MOTION_MODE_LINEAR) || (gc_block.modal.motion == MOTION_MODE_CW_ARC) 
         || (gc_block.modal.motion == MOTION_MODE_CCW_ARC)) ) {
+    #endif
       gc_parser_flags |= GC_PARSER_LASER_DISABLE;
     }
 
@@ -885,8 +1131,14 @@ uint8_t gc_execute_line(char *line)
       // M3 constant power laser requires planner syncs to update the laser when changing between
       // a G1/2/3 motion mode state and vice versa when there is no motion in the line.
       if (gc_state.modal.spindle == SPINDLE_ENABLE_CW) {
+        #ifdef ENABLE_G5_SPLINES
+        if ((gc_state.modal.motion == MOTION_MODE_LINEAR) || (gc_state.modal.motion == MOTION_MODE_CW_ARC) 
+            || (gc_state.modal.motion == MOTION_MODE_CCW_ARC) || (gc_state.modal.motion == MOTION_MODE_CUBIC_SPLINE)
+            || (gc_state.modal.motion == MOTION_MODE_QUADRATIC_SPLINE)) {
+        #else
         if ((gc_state.modal.motion == MOTION_MODE_LINEAR) || (gc_state.modal.motion == MOTION_MODE_CW_ARC) 
             || (gc_state.modal.motion == MOTION_MODE_CCW_ARC)) {
+        #endif
           if (bit_istrue(gc_parser_flags,GC_PARSER_LASER_DISABLE)) { 
             gc_parser_flags |= GC_PARSER_LASER_FORCE_SYNC; // Change from G1/2/3 motion mode.
           }
@@ -970,7 +1222,7 @@ uint8_t gc_execute_line(char *line)
   #endif
 
   // [10. Dwell ]:
-  if (gc_block.non_modal_command == NON_MODAL_DWELL) { mc_dwell(gc_block.values.p); }
+  if (gc_block.non_modal_command == NON_MODAL_DWELL) { mc_dwell(gc_block.values.p, pl_data); }
 
   // [11. Set active plane ]:
   gc_state.modal.plane_select = gc_block.modal.plane_select;
@@ -1009,7 +1261,10 @@ uint8_t gc_execute_line(char *line)
   // [17. Set distance mode ]:
   gc_state.modal.distance = gc_block.modal.distance;
 
-  // [18. Set retract mode ]: NOT SUPPORTED
+  // [18. Set retract mode ]:
+  #ifdef ENABLE_CANNED_CYCLES
+    gc_state.modal.retract = gc_block.modal.retract;
+  #endif
 
   // [19. Go to predefined position, Set G10, or Set axis offsets ]:
   switch(gc_block.non_modal_command) {
@@ -1057,10 +1312,29 @@ uint8_t gc_execute_line(char *line)
         mc_line(gc_block.values.xyz, pl_data);
       } else if (gc_state.modal.motion == MOTION_MODE_SEEK) {
         pl_data->condition |= PL_COND_FLAG_RAPID_MOTION; // Set rapid motion condition flag.
-        mc_line(gc_block.values.xyz, pl_data);
+        #ifdef INDEPENDENT_AXIS_RAPIDS
+          mc_rapid(gc_block.values.xyz, pl_data, gc_state.position);
+        #else
+          mc_line(gc_block.values.xyz, pl_data);
+        #endif
       } else if ((gc_state.modal.motion == MOTION_MODE_CW_ARC) || (gc_state.modal.motion == MOTION_MODE_CCW_ARC)) {
         mc_arc(gc_block.values.xyz, pl_data, gc_state.position, gc_block.values.ijk, gc_block.values.r,
             axis_0, axis_1, axis_linear, bit_istrue(gc_parser_flags,GC_PARSER_ARC_IS_CLOCKWISE));
+      #ifdef ENABLE_G5_SPLINES
+      } else if ((gc_state.modal.motion == MOTION_MODE_CUBIC_SPLINE) || (gc_state.modal.motion == MOTION_MODE_QUADRATIC_SPLINE)) {
+        gc_state.spline_control[X_AXIS] = gc_block.values.p;
+        gc_state.spline_control[Y_AXIS] = gc_block.values.q;
+        mc_spline(gc_block.values.xyz, pl_data, gc_state.position, gc_block.values.ijk, gc_state.spline_control);
+      #endif
+      #ifdef ENABLE_CANNED_CYCLES
+      } else if (gc_is_canned_cycle(gc_state.modal.motion)) {
+        gc_state.cycle_z = gc_block.values.ijk[Z_AXIS];
+        gc_state.cycle_initial_z = gc_block.values.ijk[X_AXIS];
+        gc_state.cycle_r = gc_block.values.r;
+        gc_state.cycle_q = gc_block.values.q;
+        gc_state.cycle_p = gc_block.values.p;
+        mc_canned_cycle(gc_block.values.xyz, pl_data, gc_state.position, &cycle_data);
+      #endif
       } else {
         // NOTE: gc_block.values.xyz is returned from mc_probe_cycle with the updated position value. So
         // upon a successful probing cycle, the machine position and the returned value should be the same.
@@ -1126,6 +1400,9 @@ uint8_t gc_execute_line(char *line)
         spindle_set_state(SPINDLE_DISABLE,0.0);
         coolant_set_state(COOLANT_DISABLE);
       }
+      #ifdef ENABLE_PROGRAM_MODE
+        sys.program_running = false; // Also ends a program missing its '%' end delimiter.
+      #endif
       report_feedback_message(MESSAGE_PROGRAM_END);
     }
     gc_state.modal.program_flow = PROGRAM_FLOW_RUNNING; // Reset program flow.
@@ -1140,7 +1417,7 @@ uint8_t gc_execute_line(char *line)
 /*
   Not supported:
 
-  - Canned cycles
+  - Canned cycles (*)
   - Tool radius compensation
   - A,B,C-axes
   - Evaluation of expressions
@@ -1151,13 +1428,13 @@ uint8_t gc_execute_line(char *line)
 
    (*) Indicates optional parameter, enabled through config.h and re-compile
    group 0 = {G92.2, G92.3} (Non modal: Cancel and re-enable G92 offsets)
-   group 1 = {G81 - G89} (Motion modes: Canned cycles)
+   group 1 = {G73*, G81* - G83*, G84 - G89} (Motion modes: Canned cycles)
    group 4 = {M1} (Optional stop, ignored)
    group 6 = {M6} (Tool change)
    group 7 = {G41, G42} cutter radius compensation (G40 is supported)
    group 8 = {G43} tool length offset (G43.1/G49 are supported)
    group 8 = {M7*} enable mist coolant (* Compile-option)
    group 9 = {M48, M49, M56*} enable/disable override switches (* Compile-option)
-   group 10 = {G98, G99} return mode canned cycles
+   group 10 = {G98*, G99*} return mode canned cycles
    group 13 = {G61.1, G64} path control mode (G61 is supported)
 */
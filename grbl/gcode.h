@@ -30,7 +30,7 @@
 // and are similar/identical to other g-code interpreters by manufacturers (Haas,Fanuc,Mazak,etc).
 // NOTE: Modal group define values must be sequential and starting from zero.
 #define MODAL_GROUP_G0 0 // [G4,G10,G28,G28.1,G30,G30.1,G53,G92,G92.1] Non-modal
-#define MODAL_GROUP_G1 1 // [G0,G1,G2,G3,G38.2,G38.3,G38.4,G38.5,G80] Motion
+#define MODAL_GROUP_G1 1 // [G0,G1,G2,G3,G5,G5.1,G38.2,G38.3,G38.4,G38.5,G73,G80,G81,G82,G83] Motion
 #define MODAL_GROUP_G2 2 // [G17,G18,G19] Plane selection
 #define MODAL_GROUP_G3 3 // [G90,G91] Distance mode
 #define MODAL_GROUP_G4 4 // [G91.1] Arc IJK distance mode
@@ -45,6 +45,7 @@
 #define MODAL_GROUP_M7 12 // [M3,M4,M5] Spindle turning
 #define MODAL_GROUP_M8 13 // [M7,M8,M9] Coolant control
 #define MODAL_GROUP_M9 14 // [M56] Override control
+#define MODAL_GROUP_G10 15 // [G98,G99] Canned cycle return mode
 
 // Define command actions for within execution-type modal groups (motion, stopping, non-modal). Used
 // internally by the parser to know which command to execute.
@@ -70,11 +71,19 @@
 #define MOTION_MODE_LINEAR 1 // G1 (Do not alter value)
 #define MOTION_MODE_CW_ARC 2  // G2 (Do not alter value)
 #define MOTION_MODE_CCW_ARC 3  // G3 (Do not alter value)
+#define MOTION_MODE_CUBIC_SPLINE 5 // G5 (Do not alter value)
+#define MOTION_MODE_QUADRATIC_SPLINE 51 // G5.1
 #define MOTION_MODE_PROBE_TOWARD 140 // G38.2 (Do not alter value)
 #define MOTION_MODE_PROBE_TOWARD_NO_ERROR 141 // G38.3 (Do not alter value)
 #define MOTION_MODE_PROBE_AWAY 142 // G38.4 (Do not alter value)
 #define MOTION_MODE_PROBE_AWAY_NO_ERROR 143 // G38.5 (Do not alter value)
 #define MOTION_MODE_NONE 80 // G80 (Do not alter value)
+#define MOTION_MODE_CHIP_BREAK_DRILL 73 // G73 (Do not alter value)
+#define MOTION_MODE_DRILL 81 // G81 (Do not alter value)
+#define MOTION_MODE_DWELL_DRILL 82 // G82 (Do not alter value)
+#define MOTION_MODE_PECK_DRILL 83 // G83 (Do not alter value)
+#define gc_is_canned_cycle(motion) (((motion) == MOTION_MODE_CHIP_BREAK_DRILL) || \
+  (((motion) >= MOTION_MODE_DRILL) && ((motion) <= MOTION_MODE_PECK_DRILL)))
 
 // Modal Group G2: Plane select
 #define PLANE_SELECT_XY 0 // G17 (Default: Must be zero)
@@ -106,6 +115,10 @@
 // Modal Group G7: Cutter radius compensation mode
 #define CUTTER_COMP_DISABLE 0 // G40 (Default: Must be zero)
 
+// Modal Group G10: Canned cycle return mode
+#define RETRACT_MODE_INITIAL 0 // G98 (Default: Must be zero)
+#define RETRACT_MODE_R_PLANE 1 // G99 (Do not alter value)
+
 // Modal Group G13: Control mode
 #define CONTROL_MODE_EXACT_PATH 0 // G61 (Default: Must be zero)
 
@@ -149,6 +162,7 @@
 #define WORD_X  10
 #define WORD_Y  11
 #define WORD_Z  12
+#define WORD_Q  13
 
 // Define g-code parser position updating flags
 #define GC_UPDATE_POS_TARGET   0 // Must be zero
@@ -194,6 +208,9 @@ typedef struct {
   uint8_t coolant;         // {M7,M8,M9}
   uint8_t spindle;         // {M3,M4,M5}
   uint8_t override;        // {M56}
+  #ifdef ENABLE_CANNED_CYCLES
+    uint8_t retract;       // {G98,G99}
+  #endif
 } gc_modal_t;
 
 typedef struct {
@@ -202,7 +219,7 @@ typedef struct {
   uint8_t l;       // G10 or canned cycles parameters
   int32_t n;       // Line number
   float p;         // G10 or dwell parameters
-  // float q;      // G82 peck drilling
+  float q;         // G5 spline control point or canned cycle peck depth
   float r;         // Arc radius
   float s;         // Spindle speed
   uint8_t t;       // Tool selection
@@ -225,6 +242,20 @@ typedef struct {
   float coord_offset[N_AXIS];    // Retains the G92 coordinate offset (work coordinates) relative to
                                  // machine zero in mm. Non-persistent. Cleared upon reset and boot.
   float tool_length_offset;      // Tracks tool length offset value when enabled.
+
+  #ifdef ENABLE_G5_SPLINES
+    float spline_control[2];     // Last G5 second control point offset from its end point in mm.
+  #endif
+
+  #ifdef ENABLE_CANNED_CYCLES
+    // Canned cycle words retained for the following holes of a cycle. Z and R are the programmed
+    // values in mm, which are converted with the distance mode of each hole.
+    float cycle_z;
+    float cycle_r;
+    float cycle_q;
+    float cycle_p;
+    float cycle_initial_z;       // Machine Z at the start of the cycle. G98 retract height.
+  #endif
 } parser_state_t;
 extern parser_state_t gc_state;
 
@@ -239,8 +270,8 @@ typedef struct {
 // Initialize the parser
 void gc_init();
 
-// Execute one block of rs275/ngc/g-code
-uint8_t gc_execute_line(char *line);
+// Execute one block of rs275/ngc/g-code, starting at index char_counter of line
+uint8_t gc_execute_line(char *line, uint8_t char_counter);
 
 // Set g-code parser position. Input in steps.
 void gc_sync_position();
@@ -50,6 +50,9 @@
 #include "spindle_control.h"
 #include "stepper.h"
 #include "jog.h"
+#include "mesh.h"
+#include "binary.h"
+#include "subprogram.h"
 
 // ---------------------------------------------------------------------------------------
 // COMPILE-TIME ERROR CHECKING OF DEFINE VALUES:
@@ -88,6 +91,103 @@
   #endif
 #endif
 
+#if !((SPT_PERIOD_BITS == 16) || (SPT_PERIOD_BITS == 32))
+  #error "SPT_PERIOD_BITS must be 16 or 32."
+#endif
+
+#if defined(STEP_BURST_MODE)
+  #if defined(STEP_PULSE_DELAY)
+    #error "STEP_BURST_MODE is not supported with STEP_PULSE_DELAY."
+  #endif
+  #if (STEP_BURST_CUTOFF_HZ < 16000)
+    #error "STEP_BURST_CUTOFF_HZ must be at least 16000."
+  #endif
+  #if (STEP_BURST_MAX_LEVEL < 1) || (STEP_BURST_MAX_LEVEL > 3)
+    #error "STEP_BURST_MAX_LEVEL must be between 1 and 3."
+  #endif
+#endif
+
+#if defined(DDA_STEP_ENGINE)
+  #if defined(ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING)
+    #error "DDA_STEP_ENGINE requires ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING to be disabled."
+  #endif
+  #if defined(STEP_BURST_MODE)
+    #error "DDA_STEP_ENGINE is not supported with STEP_BURST_MODE."
+  #endif
+#endif
+
+#if defined(HOMING_LATCH_TRIGGER_POSITION)
+  #if defined(ENABLE_SOFTWARE_DEBOUNCE)
+    #error "HOMING_LATCH_TRIGGER_POSITION is not supported with ENABLE_SOFTWARE_DEBOUNCE."
+  #endif
+  #if defined(COREXY)
+    #error "HOMING_LATCH_TRIGGER_POSITION is not supported with COREXY."
+  #endif
+  #if defined(ENABLE_DUAL_AXIS)
+    #error "HOMING_LATCH_TRIGGER_POSITION is not supported with ENABLE_DUAL_AXIS."
+  #endif
+#endif
+
+#if defined(HOMING_PARALLEL_AXES) && defined(COREXY)
+  #error "HOMING_PARALLEL_AXES is not supported with COREXY."
+#endif
+
+#if defined(NATIVE_ARC_BLOCKS)
+  #if defined(COREXY)
+    #error "NATIVE_ARC_BLOCKS is not supported with COREXY."
+  #endif
+  #if defined(DDA_STEP_ENGINE)
+    #error "NATIVE_ARC_BLOCKS is not supported with DDA_STEP_ENGINE."
+  #endif
+#endif
+
+#if defined(ENABLE_BACKLASH_COMPENSATION)
+  #if defined(COREXY)
+    #error "ENABLE_BACKLASH_COMPENSATION is not supported with COREXY."
+  #endif
+  #if defined(NATIVE_ARC_BLOCKS)
+    #error "ENABLE_BACKLASH_COMPENSATION is not supported with NATIVE_ARC_BLOCKS."
+  #endif
+#endif
+
+#if defined(RX_BUFFER_LINE_PARSING)
+  #if defined(REPORT_ECHO_LINE_RECEIVED)
+    #error "RX_BUFFER_LINE_PARSING is not supported with REPORT_ECHO_LINE_RECEIVED."
+  #endif
+  #if (RX_BUFFER_SIZE > 254)
+    #error "RX_BUFFER_LINE_PARSING requires an RX_BUFFER_SIZE of 254 or less."
+  #endif
+  #if (LINE_BUFFER_SIZE >= RX_BUFFER_SIZE)
+    #error "RX_BUFFER_LINE_PARSING requires LINE_BUFFER_SIZE to be less than RX_BUFFER_SIZE."
+  #endif
+#endif
+
+#if defined(ENABLE_BINARY_PROTOCOL) && defined(RX_BUFFER_LINE_PARSING)
+  #error "ENABLE_BINARY_PROTOCOL is not supported with RX_BUFFER_LINE_PARSING."
+#endif
+
+#if defined(DEFERRED_CYCLE_START)
+  #if (DEFERRED_START_TIMEOUT < 1) || (DEFERRED_START_TIMEOUT > 255)
+    #error "DEFERRED_START_TIMEOUT must be between 1 and 255."
+  #endif
+#endif
+
+#if defined(ENABLE_SUBPROGRAMS) && defined(ENABLE_MESH_LEVELING)
+  #error "ENABLE_SUBPROGRAMS is not supported with ENABLE_MESH_LEVELING."
+#endif
+
+#if defined(ENABLE_MESH_LEVELING)
+  #if defined(NATIVE_ARC_BLOCKS)
+    #error "ENABLE_MESH_LEVELING is not supported with NATIVE_ARC_BLOCKS."
+  #endif
+  #if (MESH_POINTS_X < 2) || (MESH_POINTS_X > 16) || (MESH_POINTS_Y < 2) || (MESH_POINTS_Y > 16)
+    #error "MESH_POINTS_X and MESH_POINTS_Y must be between 2 and 16."
+  #endif
+  #if (MESH_POINTS_X*MESH_POINTS_Y > 59)
+    #error "Mesh exceeds its EEPROM space. Reduce MESH_POINTS_X or MESH_POINTS_Y."
+  #endif
+#endif
+
 #if (REPORT_WCO_REFRESH_BUSY_COUNT < REPORT_WCO_REFRESH_IDLE_COUNT)
   #error "WCO busy refresh is less than idle refresh."
 #endif
@@ -38,6 +38,11 @@
   #define DUAL_AXIS_CHECK_TRIGGER_2   bit(2)
 #endif
 
+#ifdef HOMING_LATCH_TRIGGER_POSITION
+  static volatile uint8_t homing_latch_axes;    // Cycle axes still approaching their limit switches.
+  static int32_t homing_latch_position[N_AXIS]; // Latched limit trigger positions in steps.
+#endif
+
 void limits_init()
 {
   GPIO_INIT_PINS(LIMIT);
@@ -107,6 +112,13 @@ uint8_t limits_get_state()
 #ifndef ENABLE_SOFTWARE_DEBOUNCE
   ISR(LIMIT_INT_vect) // DEFAULT: Limit pin change interrupt process.
   {
+    #ifdef HOMING_LATCH_TRIGGER_POSITION
+      // Only enabled during homing for the approach. Latch the trigger positions instead of alarming.
+      if (sys.state == STATE_HOMING) {
+        st_homing_latch();
+        return;
+      }
+    #endif
     // Ignore limit switches if already in an alarm state or in-process of executing an alarm.
     // When in the alarm state, Grbl should have been reset or will force a reset, so any pending
     // moves in the planner and serial buffers are all cleared and newly sent blocks will be
@@ -145,6 +157,27 @@ uint8_t limits_get_state()
   }
 #endif
 
+#ifdef HOMING_LATCH_TRIGGER_POSITION
+  // Latches the position of the approaching homing cycle axes whose limit switches have triggered
+  // and locks them out of the homing motion. Called through st_homing_latch() only, so the machine
+  // position is never read while the stepper ISR is updating it.
+  void limits_homing_latch()
+  {
+    uint8_t triggered = limits_get_state() & homing_latch_axes;
+    if (triggered) {
+      uint8_t idx;
+      for (idx=0; idx<N_AXIS; idx++) {
+        if (triggered & bit(idx)) {
+          homing_latch_position[idx] = sys_position[idx];
+          sys.homing_axis_lock &= ~get_step_pin_mask(idx);
+        }
+      }
+      homing_latch_axes &= ~triggered;
+    }
+  }
+#endif
+
+
 // Homes the specified cycle axes, sets the machine position, and performs a pull-off motion after
 // completing. Homing is a special motion case, which involves rapid uncontrolled stops to locate
 // the trigger point of the limit switches. The rapid stops are handled by a system level axis lock
@@ -166,7 +199,11 @@ void limits_go_home(uint8_t cycle_mask)
   #endif
 
   // Initialize variables used for homing computations.
-  uint8_t n_cycle = (2*N_HOMING_LOCATE_CYCLE+1);
+  #ifdef HOMING_LATCH_TRIGGER_POSITION
+    uint8_t n_cycle = 1; // Seek approach and pull-off only. The latch replaces the locate cycles.
+  #else
+    uint8_t n_cycle = (2*N_HOMING_LOCATE_CYCLE+1);
+  #endif
   uint8_t step_pin[N_AXIS];
   #ifdef ENABLE_DUAL_AXIS
     uint8_t step_pin_dual;
@@ -205,8 +242,18 @@ void limits_go_home(uint8_t cycle_mask)
   // Set search mode with approach at seek rate to quickly engage the specified cycle_mask limit switches.
   bool approach = true;
   float homing_rate = settings.homing_seek_rate;
+  #ifdef HOMING_PARALLEL_AXES
+    uint8_t search = true; // First approach searches the full axis travel.
+    float axis_rate[N_AXIS];
+    float travel_time;
+  #else
+    uint8_t n_active_axis;
+  #endif
 
-  uint8_t limit_state, axislock, n_active_axis;
+  uint8_t axislock;
+  #ifndef HOMING_LATCH_TRIGGER_POSITION
+    uint8_t limit_state;
+  #endif
   do {
 
     system_convert_array_steps_to_mpos(target,sys_position);
@@ -218,11 +265,34 @@ void limits_go_home(uint8_t cycle_mask)
       dual_trigger_position = 0;
       dual_axis_async_check = DUAL_AXIS_CHECK_DISABLE;
     #endif
-    n_active_axis = 0;
+    #ifdef HOMING_PARALLEL_AXES
+      // On approach, each axis moves at its own homing rate. Axis travels are stretched to the
+      // longest travel time of the cycle axes, so the planned line holds every axis at its rate until
+      // its switch locks it out. Pull-off distances must stay exact for setting the machine position,
+      // so the axes pull off together in the time of the slowest one.
+      travel_time = 0.0;
+      homing_rate = 0.0;
+      for (idx=0; idx<N_AXIS; idx++) {
+        if (bit_istrue(cycle_mask,bit(idx))) {
+          if (approach && !search) { axis_rate[idx] = settings.homing_axis_feed_rate[idx]; }
+          else { axis_rate[idx] = settings.homing_axis_seek_rate[idx]; }
+          if (search) { max_travel = (-HOMING_AXIS_SEARCH_SCALAR)*settings.max_travel[idx]; }
+          travel_time = max(travel_time, max_travel/axis_rate[idx]);
+          if (approach) { homing_rate += axis_rate[idx]*axis_rate[idx]; }
+          else { homing_rate += max_travel*max_travel; }
+        }
+      }
+      homing_rate = sqrt(homing_rate);
+      if (!approach) { homing_rate /= travel_time; }
+    #else
+      n_active_axis = 0;
+    #endif
     for (idx=0; idx<N_AXIS; idx++) {
       // Set target location for active axes and setup computation for homing rate.
       if (bit_istrue(cycle_mask,bit(idx))) {
-        n_active_axis++;
+        #ifndef HOMING_PARALLEL_AXES
+          n_active_axis++;
+        #endif
         #ifdef COREXY
           if (idx == X_AXIS) {
             int32_t axis_position = system_convert_corexy_to_y_axis_steps(sys_position);
@@ -234,9 +304,14 @@ void limits_go_home(uint8_t cycle_mask)
           } else {
             sys_position[Z_AXIS] = 0;
           }
+        #elif defined(HOMING_LATCH_TRIGGER_POSITION)
+          if (approach) { sys_position[idx] = 0; } // Pull-off starts from the restored latched position.
         #else
           sys_position[idx] = 0;
         #endif
+        #ifdef HOMING_PARALLEL_AXES
+          if (approach) { max_travel = axis_rate[idx]*travel_time; }
+        #endif
         // Set target direction based on cycle mask and homing cycle approach state.
         // NOTE: This happens to compile smaller than any other implementation tried.
         if (bit_istrue(settings.homing_dir_mask,bit(idx))) {
@@ -246,6 +321,9 @@ void limits_go_home(uint8_t cycle_mask)
           if (approach) { target[idx] = max_travel; }
           else { target[idx] = -max_travel; }
         }
+        #ifdef HOMING_LATCH_TRIGGER_POSITION
+          if (!approach) { target[idx] += homing_latch_position[idx]/settings.steps_per_mm[idx]; }
+        #endif
         // Apply axislock to the step port pins active in this cycle.
         axislock |= step_pin[idx];
         #ifdef ENABLE_DUAL_AXIS
@@ -254,8 +332,19 @@ void limits_go_home(uint8_t cycle_mask)
       }
 
     }
-    homing_rate *= sqrt(n_active_axis); // [sqrt(N_AXIS)] Adjust so individual axes all move at homing rate.
+    #ifndef HOMING_PARALLEL_AXES
+      homing_rate *= sqrt(n_active_axis); // [sqrt(N_AXIS)] Adjust so individual axes all move at homing rate.
+    #endif
     sys.homing_axis_lock = axislock;
+    #ifdef HOMING_LATCH_TRIGGER_POSITION
+      if (approach) {
+        // Hand the trigger detection to the limit pin change interrupt. Latch any switch that is
+        // already engaged, since it will not generate a pin change.
+        homing_latch_axes = cycle_mask;
+        GPIO_IRQ_PINS(LIMIT, true);
+        st_homing_latch();
+      }
+    #endif
 
     // Perform homing cycle. Planner buffer should be empty, as required to initiate the homing cycle.
     pl_data->feed_rate = homing_rate; // Set current homing rate.
@@ -266,50 +355,54 @@ void limits_go_home(uint8_t cycle_mask)
     st_wake_up(); // Initiate motion
     do {
       if (approach) {
-        // Check limit state. Lock out cycle axes when they change.
-        limit_state = limits_get_state();
-        for (idx=0; idx<N_AXIS; idx++) {
-          if (axislock & step_pin[idx]) {
-            if (limit_state & (1 << idx)) {
-              #ifdef COREXY
-                if (idx==Z_AXIS) { axislock &= ~(step_pin[Z_AXIS]); }
-                else { axislock &= ~(step_pin[A_MOTOR]|step_pin[B_MOTOR]); }
-              #else
-                axislock &= ~(step_pin[idx]);
-                #ifdef ENABLE_DUAL_AXIS
-                  if (idx == DUAL_AXIS_SELECT) { dual_axis_async_check |= DUAL_AXIS_CHECK_TRIGGER_1; }
+        #ifdef HOMING_LATCH_TRIGGER_POSITION
+          axislock = sys.homing_axis_lock; // Triggered axes are locked out by the limit interrupt.
+        #else
+          // Check limit state. Lock out cycle axes when they change.
+          limit_state = limits_get_state();
+          for (idx=0; idx<N_AXIS; idx++) {
+            if (axislock & step_pin[idx]) {
+              if (limit_state & (1 << idx)) {
+                #ifdef COREXY
+                  if (idx==Z_AXIS) { axislock &= ~(step_pin[Z_AXIS]); }
+                  else { axislock &= ~(step_pin[A_MOTOR]|step_pin[B_MOTOR]); }
+                #else
+                  axislock &= ~(step_pin[idx]);
+                  #ifdef ENABLE_DUAL_AXIS
+                    if (idx == DUAL_AXIS_SELECT) { dual_axis_async_check |= DUAL_AXIS_CHECK_TRIGGER_1; }
+                  #endif
                 #endif
-              #endif
+              }
             }
           }
-        }
-        sys.homing_axis_lock = axislock;
-        #ifdef ENABLE_DUAL_AXIS
-          if (sys.homing_axis_lock_dual) { // NOTE: Only true when homing dual axis.
-            if (limit_state & (1 << N_AXIS)) { 
-              sys.homing_axis_lock_dual = 0;
-              dual_axis_async_check |= DUAL_AXIS_CHECK_TRIGGER_2;
+          sys.homing_axis_lock = axislock;
+          #ifdef ENABLE_DUAL_AXIS
+            if (sys.homing_axis_lock_dual) { // NOTE: Only true when homing dual axis.
+              if (limit_state & (1 << N_AXIS)) { 
+                sys.homing_axis_lock_dual = 0;
+                dual_axis_async_check |= DUAL_AXIS_CHECK_TRIGGER_2;
+              }
             }
-          }
           
-          // When first dual axis limit triggers, record position and begin checking distance until other limit triggers. Bail upon failure.
-          if (dual_axis_async_check) {
-            if (dual_axis_async_check & DUAL_AXIS_CHECK_ENABLE) {
-              if (( dual_axis_async_check &  (DUAL_AXIS_CHECK_TRIGGER_1 | DUAL_AXIS_CHECK_TRIGGER_2)) == (DUAL_AXIS_CHECK_TRIGGER_1 | DUAL_AXIS_CHECK_TRIGGER_2)) {
-                dual_axis_async_check = DUAL_AXIS_CHECK_DISABLE;
-              } else {
-                if (abs(dual_trigger_position - sys_position[DUAL_AXIS_SELECT]) > dual_fail_distance) {
-                  system_set_exec_alarm(EXEC_ALARM_HOMING_FAIL_DUAL_APPROACH);
-                  mc_reset();
-                  protocol_execute_realtime();
-                  return;
+            // When first dual axis limit triggers, record position and begin checking distance until other limit triggers. Bail upon failure.
+            if (dual_axis_async_check) {
+              if (dual_axis_async_check & DUAL_AXIS_CHECK_ENABLE) {
+                if (( dual_axis_async_check &  (DUAL_AXIS_CHECK_TRIGGER_1 | DUAL_AXIS_CHECK_TRIGGER_2)) == (DUAL_AXIS_CHECK_TRIGGER_1 | DUAL_AXIS_CHECK_TRIGGER_2)) {
+                  dual_axis_async_check = DUAL_AXIS_CHECK_DISABLE;
+                } else {
+                  if (abs(dual_trigger_position - sys_position[DUAL_AXIS_SELECT]) > dual_fail_distance) {
+                    system_set_exec_alarm(EXEC_ALARM_HOMING_FAIL_DUAL_APPROACH);
+                    mc_reset();
+                    protocol_execute_realtime();
+                    return;
+                  }
                 }
+              } else {
+                dual_axis_async_check |= DUAL_AXIS_CHECK_ENABLE;
+                dual_trigger_position = sys_position[DUAL_AXIS_SELECT];
               }
-            } else {
-              dual_axis_async_check |= DUAL_AXIS_CHECK_ENABLE;
-              dual_trigger_position = sys_position[DUAL_AXIS_SELECT];
             }
-          }
+          #endif
         #endif
       }
 
@@ -344,10 +437,22 @@ void limits_go_home(uint8_t cycle_mask)
     #endif
 
     st_reset(); // Immediately force kill steppers and reset step segment buffer.
+    #ifdef HOMING_LATCH_TRIGGER_POSITION
+      if (approach) {
+        limits_disable();
+        // Locked axes kept counting the steps they did not take. Restore their latched positions.
+        for (idx=0; idx<N_AXIS; idx++) {
+          if (bit_istrue(cycle_mask,bit(idx))) { sys_position[idx] = homing_latch_position[idx]; }
+        }
+      }
+    #endif
     delay_ms(settings.homing_debounce_delay); // Delay to allow transient dynamics to dissipate.
 
     // Reverse direction and reset homing rate for locate cycle(s).
     approach = !approach;
+    #ifdef HOMING_PARALLEL_AXES
+      search = false;
+    #endif
 
     // After first cycle, homing enters locating phase. Shorten search to pull-off distance.
     if (approach) {
@@ -399,6 +504,9 @@ void limits_go_home(uint8_t cycle_mask)
 
     }
   }
+  #ifdef ENABLE_BACKLASH_COMPENSATION
+    plan_reset_backlash(cycle_mask); // Backlash is taken up in the pull-off direction.
+  #endif
   sys.step_control = STEP_CONTROL_NORMAL_OP; // Return step control to normal operation.
 }
 
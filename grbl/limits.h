@@ -35,6 +35,11 @@ uint8_t limits_get_state();
 // Perform one portion of the homing cycle based on the input settings.
 void limits_go_home(uint8_t cycle_mask);
 
+#ifdef HOMING_LATCH_TRIGGER_POSITION
+  // Latch the trigger positions of homing axes whose limit switches engaged. Via st_homing_latch() only.
+  void limits_homing_latch();
+#endif
+
 // Check for soft limit violations
 void limits_soft_check(float *target);
 
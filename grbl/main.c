@@ -41,6 +41,12 @@ int main(void)
   // Initialize system upon power-up.
   serial_init();   // Setup serial baud rate and interrupts
   settings_init(); // Load Grbl settings from EEPROM
+  #ifdef ENABLE_MESH_LEVELING
+    mesh_init();   // Load leveling mesh from EEPROM
+  #endif
+  #ifdef ENABLE_SUBPROGRAMS
+    subprogram_init(); // Check stored subprograms in EEPROM
+  #endif
   stepper_init();  // Configure stepper pins and interrupt timers
   system_init();   // Configure pinout pins and pin-change interrupt
 
@@ -87,11 +93,17 @@ int main(void)
     // Reset Grbl primary systems.
     serial_reset_read_buffer(); // Clear serial read buffer
     gc_init(); // Set g-code parser to default state
+    #ifdef ENABLE_SUBPROGRAMS
+      subprogram_reset(); // Drop an unfinished subprogram definition
+    #endif
     spindle_init();
     coolant_init();
     limits_init();
     probe_init();
     plan_reset(); // Clear block buffer and planner variables
+    #ifdef PARSE_AHEAD_QUEUE
+      mc_queue_reset(); // Clear parsed motions not yet planned
+    #endif
     st_reset(); // Clear stepper subsystem variables.
 
     // Sync cleared gcode and planner positions to current system position.
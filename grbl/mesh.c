@@ -0,0 +1,110 @@
+/*
+  mesh.c - height-map mesh leveling data and interpolation
+  Part of Grbl
+
+  Copyright (c) 2026 agent
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "grbl.h"
+
+#ifdef ENABLE_MESH_LEVELING
+
+mesh_t mesh;
+
+
+void mesh_init()
+{
+  if (!(memcpy_from_eeprom_with_checksum((char*)&mesh, EEPROM_ADDR_MESH, sizeof(mesh_t)))) {
+    memset(&mesh, 0, sizeof(mesh_t)); // No grid defined. Compensation disabled.
+  }
+}
+
+
+void mesh_store()
+{
+  memcpy_to_eeprom_with_checksum(EEPROM_ADDR_MESH, (char*)&mesh, sizeof(mesh_t));
+}
+
+
+uint8_t mesh_set_grid(float *grid)
+{
+  if ((grid[2] <= 0.0) || (grid[3] <= 0.0)) { return(STATUS_NEGATIVE_VALUE); }
+  protocol_buffer_synchronize(); // Queued motions are offset by the current mesh.
+  if (sys.abort) { return(STATUS_OK); }
+  memset(&mesh, 0, sizeof(mesh_t));
+  memcpy(mesh.origin, grid, sizeof(mesh.origin));
+  memcpy(mesh.spacing, &grid[2], sizeof(mesh.spacing));
+  gc_sync_position(); // Parser position no longer has an offset removed.
+  return(STATUS_OK);
+}
+
+
+void mesh_set_point(uint8_t n, float z)
+{
+  protocol_buffer_synchronize(); // Queued motions are offset by the current mesh.
+  if (sys.abort) { return; }
+  mesh.z[n/MESH_POINTS_X][n%MESH_POINTS_X] = z;
+  gc_sync_position(); // Offset at the current position may have changed.
+}
+
+
+uint8_t mesh_set_enabled(uint8_t enable)
+{
+  if (enable && (mesh.spacing[X_AXIS] == 0.0)) { return(STATUS_SETTING_DISABLED); }
+  protocol_buffer_synchronize(); // Queued motions are offset by the current mesh.
+  if (sys.abort) { return(STATUS_OK); }
+  mesh.enabled = enable;
+  gc_sync_position(); // Machine position is unchanged, so the parser position absorbs the offset.
+  return(STATUS_OK);
+}
+
+
+int8_t mesh_get_cell(float value, uint8_t axis)
+{
+  uint8_t n_points = (axis == X_AXIS) ? MESH_POINTS_X : MESH_POINTS_Y;
+  float cell = floor((value-mesh.origin[axis])/mesh.spacing[axis]);
+  if (cell < 0.0) { return(-1); }
+  if (cell > n_points-1) { return(n_points-1); }
+  return((int8_t)cell);
+}
+
+
+float mesh_get_offset(float x, float y)
+{
+  // Fractional grid position, clamped to the grid. The last cell is used for the far edge.
+  float u = (x-mesh.origin[X_AXIS])/mesh.spacing[X_AXIS];
+  float v = (y-mesh.origin[Y_AXIS])/mesh.spacing[Y_AXIS];
+  if (u < 0.0) { u = 0.0; } else if (u > MESH_POINTS_X-1) { u = MESH_POINTS_X-1; }
+  if (v < 0.0) { v = 0.0; } else if (v > MESH_POINTS_Y-1) { v = MESH_POINTS_Y-1; }
+  uint8_t i = u;
+  uint8_t j = v;
+  if (i > MESH_POINTS_X-2) { i = MESH_POINTS_X-2; }
+  if (j > MESH_POINTS_Y-2) { j = MESH_POINTS_Y-2; }
+  u -= i;
+  v -= j;
+
+  float z_lower = mesh.z[j][i] + u*(mesh.z[j][i+1]-mesh.z[j][i]);
+  float z_upper = mesh.z[j+1][i] + u*(mesh.z[j+1][i+1]-mesh.z[j+1][i]);
+  return(z_lower + v*(z_upper-z_lower));
+}
+
+
+void mesh_remove_offset(float *position)
+{
+  if (mesh.enabled) { position[Z_AXIS] -= mesh_get_offset(position[X_AXIS], position[Y_AXIS]); }
+}
+
+#endif
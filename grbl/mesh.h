@@ -0,0 +1,65 @@
+/*
+  mesh.h - height-map mesh leveling data and interpolation
+  Part of Grbl
+
+  Copyright (c) 2026 agent
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef mesh_h
+#define mesh_h
+
+#ifdef ENABLE_MESH_LEVELING
+
+// Height-map mesh. Grid point (i,j) is located at origin + (i,j)*spacing in machine coordinates.
+// NOTE: Stored in EEPROM as a whole, so the layout must not change without clearing the EEPROM copy.
+typedef struct {
+  float origin[2];  // Machine X and Y position of grid point (0,0) [mm]
+  float spacing[2]; // Distance between grid points along X and Y [mm]. Zero until a grid is defined.
+  float z[MESH_POINTS_Y][MESH_POINTS_X]; // Z offset of each grid point [mm]
+  uint8_t enabled;  // Compensation is applied to line motions when true.
+} mesh_t;
+extern mesh_t mesh;
+
+// Loads the mesh from EEPROM. Clears it, if the stored copy is missing or corrupt.
+void mesh_init();
+
+// Saves the current mesh, including its enable state, to EEPROM.
+void mesh_store();
+
+// Defines a new grid from {x0,y0,dx,dy}. Clears all Z offsets and disables compensation.
+uint8_t mesh_set_grid(float *grid);
+
+// Sets the Z offset of grid point n, counted along X first and then Y.
+void mesh_set_point(uint8_t n, float z);
+
+// Enables or disables compensation. Requires a defined grid to enable.
+uint8_t mesh_set_enabled(uint8_t enable);
+
+// Returns the grid cell index of a machine X or Y position. Positions before the first grid line
+// return -1 and positions past the last return MESH_POINTS-1, where the offset no longer varies.
+int8_t mesh_get_cell(float value, uint8_t axis);
+
+// Returns the bilinearly interpolated mesh Z offset at machine position x,y. Positions off the
+// grid take the value of the nearest grid edge.
+float mesh_get_offset(float x, float y);
+
+// Removes the mesh offset from a machine position, if compensation is enabled. Converts the
+// planner and stepper positions back into the uncompensated positions used by the g-code parser.
+void mesh_remove_offset(float *position);
+
+#endif
+
+#endif
@@ -22,6 +22,195 @@
 #include "grbl.h"
 
 
+#ifdef PARSE_AHEAD_QUEUE
+  // Parsed line motions waiting for room in the planner buffer.
+  typedef struct {
+    float target[N_AXIS];
+    plan_line_data_t pl_data;
+  } mc_queue_t;
+  static mc_queue_t mc_queue[PARSE_AHEAD_QUEUE_SIZE];
+  static uint8_t mc_queue_tail;  // Oldest queued motion
+  static uint8_t mc_queue_count;
+  static uint8_t mc_queue_busy;  // Set while draining. Buffer syncs during a drain must not drain.
+#endif
+
+
+// Plans a line motion into the planner buffer, which must have room for it.
+static void mc_plan_line(float *target, plan_line_data_t *pl_data)
+{
+  if (plan_buffer_line(target, pl_data) == PLAN_EMPTY_BLOCK) {
+    if (bit_istrue(settings.flags,BITFLAG_LASER_MODE)) {
+      // Correctly set spindle state, if there is a coincident position passed. Forces a buffer
+      // sync while in M3 laser mode only.
+      if (pl_data->condition & PL_COND_FLAG_SPINDLE_CW) {
+        spindle_sync(PL_COND_FLAG_SPINDLE_CW, pl_data->spindle_speed);
+      }
+    }
+  }
+}
+
+
+#ifdef PARSE_AHEAD_QUEUE
+  uint8_t mc_queue_drain()
+  {
+    if (mc_queue_busy) { return(false); }
+    mc_queue_busy = true;
+    while (mc_queue_count && !plan_check_full_buffer()) {
+      // Released only after planning, so the entry stays intact through a laser mode spindle sync.
+      mc_plan_line(mc_queue[mc_queue_tail].target, &mc_queue[mc_queue_tail].pl_data);
+      if (++mc_queue_tail == PARSE_AHEAD_QUEUE_SIZE) { mc_queue_tail = 0; }
+      mc_queue_count--;
+      if (sys.abort) { break; }
+    }
+    mc_queue_busy = false;
+    return(mc_queue_count);
+  }
+
+
+  void mc_queue_flush()
+  {
+    while (mc_queue_drain()) {
+      protocol_auto_cycle_start(); // Planner buffer is full. Start it to make room.
+      protocol_execute_realtime(); // Check for any run-time commands
+      if (sys.abort) { return; } // Bail, if system abort.
+    }
+  }
+
+
+  #ifdef ENABLE_MESH_LEVELING
+    // Returns the end position of the last queued motion, or the planner position, if none is queued.
+    // Queued motions are not in the planner yet.
+    static void mc_queue_get_end_mpos(float *target)
+    {
+      if (mc_queue_count) {
+        uint8_t idx = mc_queue_tail+mc_queue_count-1;
+        if (idx >= PARSE_AHEAD_QUEUE_SIZE) { idx -= PARSE_AHEAD_QUEUE_SIZE; }
+        memcpy(target, mc_queue[idx].target, sizeof(mc_queue[idx].target));
+      } else {
+        plan_get_planner_mpos(target);
+      }
+    }
+  #endif
+
+
+  void mc_queue_reset()
+  {
+    mc_queue_tail = 0;
+    mc_queue_count = 0;
+    mc_queue_busy = false;
+  }
+#endif
+
+
+// Waits for room in the planner buffer and queues a line motion. Called by mc_line() only.
+static void mc_buffer_line(float *target, plan_line_data_t *pl_data)
+{
+  #ifdef PARSE_AHEAD_QUEUE
+    // Jog and probe motions, flagged as not feed overridable, and native arc geometry are not kept
+    // in the queue. These are planned directly, after the motions queued before them.
+    #ifdef NATIVE_ARC_BLOCKS
+      if ((pl_data->condition & PL_COND_FLAG_NO_FEED_OVERRIDE) || (pl_data->arc != NULL)) { mc_queue_flush(); }
+    #else
+      if (pl_data->condition & PL_COND_FLAG_NO_FEED_OVERRIDE) { mc_queue_flush(); }
+    #endif
+    else if (mc_queue_drain() || plan_check_full_buffer()) {
+      // Planner is busy. Queue the motion and return to parse ahead. Waits only on a full queue.
+      while (mc_queue_count == PARSE_AHEAD_QUEUE_SIZE) {
+        protocol_auto_cycle_start(); // Auto-cycle start when buffer is full.
+        protocol_execute_realtime(); // Check for any run-time commands
+        if (sys.abort) { return; } // Bail, if system abort.
+        mc_queue_drain();
+      }
+      uint8_t idx = mc_queue_tail+mc_queue_count;
+      if (idx >= PARSE_AHEAD_QUEUE_SIZE) { idx -= PARSE_AHEAD_QUEUE_SIZE; }
+      memcpy(mc_queue[idx].target, target, sizeof(mc_queue[idx].target));
+      memcpy(&mc_queue[idx].pl_data, pl_data, sizeof(plan_line_data_t));
+      mc_queue_count++;
+      protocol_auto_cycle_start();
+      return;
+    }
+  #endif
+
+  // If the buffer is full: good! That means we are well ahead of the robot.
+  // Remain in this loop until there is room in the buffer.
+  do {
+    protocol_execute_realtime(); // Check for any run-time commands
+    if (sys.abort) { return; } // Bail, if system abort.
+    if ( plan_check_full_buffer() ) { protocol_auto_cycle_start(); } // Auto-cycle start when buffer is full.
+    else { break; }
+  } while (1);
+
+  // Plan and queue motion into planner buffer
+  mc_plan_line(target, pl_data);
+}
+
+
+#ifdef ENABLE_MESH_LEVELING
+  // Splits a line motion where it crosses the mesh grid lines and raises each segment end point by
+  // the mesh offset. The offset is bilinear within a cell, so a straight segment across a cell only
+  // deviates from the surface by the cell's small twist term. Crossings are walked by cell index
+  // rather than by position, so a segment ending exactly on a grid line cannot stall the loop.
+  static void mc_mesh_line(float *target, plan_line_data_t *pl_data)
+  {
+    // Recover the uncompensated start point from the last motion. The offset does not alter X or Y.
+    float start[N_AXIS];
+    float delta[N_AXIS];
+    #ifdef PARSE_AHEAD_QUEUE
+      mc_queue_get_end_mpos(start);
+    #else
+      plan_get_planner_mpos(start);
+    #endif
+    mesh_remove_offset(start);
+    uint8_t idx;
+    for (idx=0; idx<N_AXIS; idx++) { delta[idx] = target[idx]-start[idx]; }
+
+    int8_t cell[2], cell_end[2];
+    for (idx=X_AXIS; idx<=Y_AXIS; idx++) {
+      cell[idx] = mesh_get_cell(start[idx], idx);
+      cell_end[idx] = mesh_get_cell(target[idx], idx);
+    }
+
+    float feed_rate = pl_data->feed_rate;
+    float segment[N_AXIS];
+    float t_line[2];
+    float t = 0.0;
+    float t_next;
+    do {
+      // Locate the next grid line crossed along X and Y as a fraction of the line motion.
+      for (idx=X_AXIS; idx<=Y_AXIS; idx++) {
+        t_line[idx] = 1.0;
+        if (cell[idx] != cell_end[idx]) {
+          int8_t grid_line = cell[idx] + (cell_end[idx] > cell[idx]);
+          t_line[idx] = (mesh.origin[idx] + grid_line*mesh.spacing[idx] - start[idx])/delta[idx];
+        }
+      }
+      t_next = min(t_line[X_AXIS], t_line[Y_AXIS]);
+      for (idx=X_AXIS; idx<=Y_AXIS; idx++) {
+        if ((cell[idx] != cell_end[idx]) && (t_line[idx] <= t_next)) {
+          if (cell_end[idx] > cell[idx]) { cell[idx]++; } else { cell[idx]--; }
+        }
+      }
+      if (t_next >= 1.0) {
+        memcpy(segment, target, sizeof(segment));
+      } else {
+        for (idx=0; idx<N_AXIS; idx++) { segment[idx] = start[idx] + t_next*delta[idx]; }
+      }
+
+      // Skip the empty segment of two grid lines crossed at once, or of round-off near a crossing.
+      if (t_next > t) {
+        segment[Z_AXIS] += mesh_get_offset(segment[X_AXIS], segment[Y_AXIS]);
+        // Inverse time feed rates apply to the whole motion. Scale to keep each segment's time share.
+        if (pl_data->condition & PL_COND_FLAG_INVERSE_TIME) { pl_data->feed_rate = feed_rate/(t_next-t); }
+        mc_buffer_line(segment, pl_data);
+        if (sys.abort) { break; }
+        t = t_next;
+      }
+    } while (t_next < 1.0);
+    pl_data->feed_rate = feed_rate;
+  }
+#endif
+
+
 // Execute linear motion in absolute millimeter coordinates. Feed rate given in millimeters/second
 // unless invert_feed_rate is true. Then the feed_rate means that the motion should be completed in
 // (1 minute)/feed_rate time.
@@ -41,40 +230,60 @@ void mc_line(float *target, plan_line_data_t *pl_data)
   // If in check gcode mode, prevent motion by blocking planner. Soft limits still work.
   if (sys.state == STATE_CHECK_MODE) { return; }
 
-  // NOTE: Backlash compensation may be installed here. It will need direction info to track when
-  // to insert a backlash line motion(s) before the intended line motion and will require its own
-  // plan_check_full_buffer() and check for system abort loop. Also for position reporting
-  // backlash steps will need to be also tracked, which will need to be kept at a system level.
-  // There are likely some other things that will need to be tracked as well. However, we feel
-  // that backlash compensation should NOT be handled by Grbl itself, because there are a myriad
-  // of ways to implement it and can be effective or ineffective for different CNC machines. This
-  // would be better handled by the interface as a post-processor task, where the original g-code
-  // is translated and inserts backlash motions that best suits the machine.
-  // NOTE: Perhaps as a middle-ground, all that needs to be sent is a flag or special command that
-  // indicates to Grbl what is a backlash compensation motion, so that Grbl executes the move but
-  // doesn't update the machine position values. Since the position values used by the g-code
-  // parser and planner are separate from the system machine positions, this is doable.
+  // NOTE: Backlash compensation, if enabled, is inserted by the planner. It sees every line in steps,
+  // including the mesh leveling and arc segments, and keeps the planner position free of backlash.
 
-  // If the buffer is full: good! That means we are well ahead of the robot.
-  // Remain in this loop until there is room in the buffer.
-  do {
-    protocol_execute_realtime(); // Check for any run-time commands
-    if (sys.abort) { return; } // Bail, if system abort.
-    if ( plan_check_full_buffer() ) { protocol_auto_cycle_start(); } // Auto-cycle start when buffer is full.
-    else { break; }
-  } while (1);
+  #ifdef ENABLE_MESH_LEVELING
+    if (mesh.enabled) {
+      mc_mesh_line(target, pl_data);
+      return;
+    }
+  #endif
 
-  // Plan and queue motion into planner buffer
-  if (plan_buffer_line(target, pl_data) == PLAN_EMPTY_BLOCK) {
-    if (bit_istrue(settings.flags,BITFLAG_LASER_MODE)) {
-      // Correctly set spindle state, if there is a coincident position passed. Forces a buffer
-      // sync while in M3 laser mode only.
-      if (pl_data->condition & PL_COND_FLAG_SPINDLE_CW) {
-        spindle_sync(PL_COND_FLAG_SPINDLE_CW, pl_data->spindle_speed);
+  mc_buffer_line(target, pl_data);
+}
+
+
+#ifdef INDEPENDENT_AXIS_RAPIDS
+  // Execute a rapid as a dogleg of lines, where each line moves the remaining axes in proportion to
+  // their max rates. The planner then runs every moving axis at its max rate. A line ends when the
+  // axis with the least travel time left arrives, so there is at most one line per axis.
+  void mc_rapid(float *target, plan_line_data_t *pl_data, float *position)
+  {
+    float dogleg[N_AXIS][N_AXIS];
+    float point[N_AXIS];
+    float axis_time[N_AXIS];
+    uint8_t n_lines = 0;
+    uint8_t idx;
+    memcpy(point, position, sizeof(point));
+    while (n_lines < N_AXIS) {
+      float line_time = SOME_LARGE_VALUE;
+      for (idx=0; idx<N_AXIS; idx++) {
+        axis_time[idx] = fabs(target[idx]-point[idx])/settings.max_rate[idx];
+        if ((axis_time[idx] > 0.0) && (axis_time[idx] < line_time)) { line_time = axis_time[idx]; }
+      }
+      if (line_time == SOME_LARGE_VALUE) { break; } // All axes at target.
+      for (idx=0; idx<N_AXIS; idx++) {
+        if (axis_time[idx] <= line_time) { point[idx] = target[idx]; } // Exact arrival. No roundoff.
+        else { point[idx] += (target[idx]-point[idx])*(line_time/axis_time[idx]); }
+      }
+      memcpy(dogleg[n_lines++], point, sizeof(point));
+    }
+    if (n_lines == 0) { memcpy(dogleg[n_lines++], target, sizeof(point)); } // Zero-length rapid.
+
+    // Check the whole dogleg before queueing, so a violation does not leave part of it executed.
+    if (bit_istrue(settings.flags,BITFLAG_SOFT_LIMIT_ENABLE)) {
+      for (idx=0; idx<n_lines; idx++) {
+        limits_soft_check(dogleg[idx]);
+        if (sys.abort) { return; }
       }
     }
+    for (idx=0; idx<n_lines; idx++) {
+      mc_line(dogleg[idx], pl_data);
+      if (sys.abort) { return; }
+    }
   }
-}
+#endif
 
 
 // Execute an arc in offset mode format. position == current xyz, target == target xyz,
@@ -102,6 +311,44 @@ void mc_arc(float *target, plan_line_data_t *pl_data, float *position, float *of
     if (angular_travel <= ARC_ANGULAR_TRAVEL_EPSILON) { angular_travel += 2*M_PI; }
   }
 
+  #ifdef NATIVE_ARC_BLOCKS
+    // Queue the arc as a single planner block. The step segment generator traces the true arc.
+    plan_arc_data_t arc;
+    arc.radius = radius;
+    arc.angle_start = atan2(r_axis1, r_axis0);
+    arc.angular_travel = angular_travel;
+    arc.linear_travel = target[axis_linear] - position[axis_linear];
+    arc.axis_0 = axis_0;
+    arc.axis_1 = axis_1;
+    arc.axis_linear = axis_linear;
+
+    // mc_line only checks the arc end point against the soft limits. The arc may also reach further
+    // out at the quadrant points it sweeps through, so check those too.
+    if (bit_istrue(settings.flags,BITFLAG_SOFT_LIMIT_ENABLE)) {
+      float quadrant_point[N_AXIS];
+      memcpy(quadrant_point, target, sizeof(quadrant_point));
+      uint8_t quadrant;
+      for (quadrant=0; quadrant<4; quadrant++) {
+        // Angle swept from the start point to the quadrant point in the direction of travel.
+        float sweep = quadrant*(0.5*M_PI) - arc.angle_start;
+        if (angular_travel < 0.0) { sweep = -sweep; }
+        while (sweep < 0.0) { sweep += 2*M_PI; }
+        while (sweep >= 2*M_PI) { sweep -= 2*M_PI; }
+        if (sweep < fabs(angular_travel)) {
+          quadrant_point[axis_0] = center_axis0;
+          quadrant_point[axis_1] = center_axis1;
+          if (quadrant & 0x01) { quadrant_point[axis_1] += (quadrant == 1) ? radius : -radius; }
+          else { quadrant_point[axis_0] += (quadrant == 0) ? radius : -radius; }
+          limits_soft_check(quadrant_point);
+          if (sys.abort) { return; }
+        }
+      }
+    }
+
+    pl_data->arc = &arc;
+    mc_line(target, pl_data);
+    pl_data->arc = NULL;
+  #else
   // NOTE: Segment end points are on the arc, which can lead to the arc diameter being smaller by up to
   // (2x) settings.arc_tolerance. For 99% of users, this is just fine. If a different arc segment fit
   // is desired, i.e. least-squares, midpoint on arc, just change the mm_per_arc_segment calculation.
@@ -188,13 +435,188 @@ void mc_arc(float *target, plan_line_data_t *pl_data, float *position, float *of
   }
   // Ensure last segment arrives at target location.
   mc_line(target, pl_data);
+  #endif
 }
 
 
-// Execute dwell in seconds.
-void mc_dwell(float seconds)
+#ifdef ENABLE_G5_SPLINES
+  // Returns the spline parameter step from t, such that the chord deviates from the curve by no
+  // more than the arc tolerance. Deviation of a chord over dt is ~ curvature*(chord length)^2/8,
+  // so the step shrinks in tight turns and grows on straight runs.
+  static float mc_spline_dt(float t, float *a, float *b, float *c)
+  {
+    float v[2], w[2];
+    uint8_t idx;
+    for (idx=0; idx<2; idx++) {
+      v[idx] = (3.0*a[idx]*t + 2.0*b[idx])*t + c[idx]; // First derivative
+      w[idx] = 6.0*a[idx]*t + 2.0*b[idx];              // Second derivative
+    }
+    float speed = hypot_f(v[X_AXIS], v[Y_AXIS]);
+    float cross = fabs(v[X_AXIS]*w[Y_AXIS] - v[Y_AXIS]*w[X_AXIS]);
+    float dt = 1.0 - t;
+    if (cross*dt*dt > 8.0*settings.arc_tolerance*speed) {
+      dt = sqrt(8.0*settings.arc_tolerance*speed/cross);
+    }
+    if (dt < SPLINE_MIN_SEGMENT_T) { dt = SPLINE_MIN_SEGMENT_T; }
+    return(dt);
+  }
+
+
+  // Execute a cubic Bezier spline in the XY plane. Control points are given by first_offset from
+  // position and second_offset from target. Segments are sized by mc_spline_dt().
+  void mc_spline(float *target, plan_line_data_t *pl_data, float *position, float *first_offset,
+    float *second_offset)
+  {
+    float a[2], b[2], c[2], start[2];
+    float t, dt;
+    uint8_t idx;
+    for (idx=0; idx<2; idx++) {
+      start[idx] = position[idx];
+      c[idx] = 3.0*first_offset[idx];
+      b[idx] = 3.0*(target[idx]+second_offset[idx]-start[idx]) - 2.0*c[idx];
+      a[idx] = target[idx]-start[idx] - c[idx] - b[idx];
+    }
+
+    // Segments are not of equal length, so inverse time is converted to a feed rate by the
+    // total chord length. Computed with the same steps as the motion below.
+    if (pl_data->condition & PL_COND_FLAG_INVERSE_TIME) {
+      float length = 0.0;
+      float prev[2] = { start[X_AXIS], start[Y_AXIS] };
+      float next[2];
+      t = 0.0;
+      while (t < 1.0) {
+        t += mc_spline_dt(t, a, b, c);
+        if (t > 1.0) { t = 1.0; }
+        for (idx=0; idx<2; idx++) { next[idx] = start[idx] + ((a[idx]*t + b[idx])*t + c[idx])*t; }
+        length += hypot_f(next[X_AXIS]-prev[X_AXIS], next[Y_AXIS]-prev[Y_AXIS]);
+        memcpy(prev, next, sizeof(prev));
+      }
+      pl_data->feed_rate *= length;
+      bit_false(pl_data->condition,PL_COND_FLAG_INVERSE_TIME);
+    }
+
+    t = 0.0;
+    for (;;) {
+      dt = mc_spline_dt(t, a, b, c);
+      t += dt;
+      if (t >= 1.0) { break; }
+      for (idx=0; idx<2; idx++) { position[idx] = start[idx] + ((a[idx]*t + b[idx])*t + c[idx])*t; }
+
+      mc_line(position, pl_data);
+
+      // Bail mid-spline on system abort. Runtime command check already performed by mc_line.
+      if (sys.abort) { return; }
+    }
+    // Ensure last segment arrives at target location.
+    mc_line(target, pl_data);
+  }
+#endif
+
+
+#ifdef PLAN_DWELL_BLOCKS
+  // Queues a dwell in the planner buffer, without syncing. Long dwells take more than one block.
+  static void mc_buffer_dwell(float seconds, plan_line_data_t *pl_data)
+  {
+    if (sys.state == STATE_CHECK_MODE) { return; }
+    #ifdef PARSE_AHEAD_QUEUE
+      mc_queue_flush(); // Dwell follows the queued motions.
+    #endif
+    uint32_t dwell_ms = lround(seconds*1000.0);
+    while (dwell_ms) {
+      uint16_t block_ms = (dwell_ms > 0xffff) ? 0xffff : dwell_ms;
+      do {
+        protocol_execute_realtime(); // Check for any run-time commands
+        if (sys.abort) { return; } // Bail, if system abort.
+        if ( plan_check_full_buffer() ) { protocol_auto_cycle_start(); } // Auto-cycle start when buffer is full.
+        else { break; }
+      } while (1);
+      plan_buffer_dwell(block_ms, pl_data);
+      dwell_ms -= block_ms;
+    }
+  }
+#endif
+
+
+#ifdef ENABLE_CANNED_CYCLES
+
+  // Execute a canned drilling cycle. Each hole is approached by a rapid in XY at the current height
+  // and a rapid down to the R plane, drilled at the feed rate, and left by a rapid to the retract
+  // height. G73 breaks the chip by a short retract after each peck, while G83 clears the hole to the
+  // R plane and rapids back to just above the last peck depth.
+  void mc_canned_cycle(float *target, plan_line_data_t *pl_data, float *position, mc_cycle_data_t *cycle)
+  {
+    float hole_step[2] = { 0.0, 0.0 };
+    if (cycle->incremental) {
+      hole_step[X_AXIS] = target[X_AXIS]-position[X_AXIS];
+      hole_step[Y_AXIS] = target[Y_AXIS]-position[Y_AXIS];
+    }
+
+    // Preliminary motion. Rapid up to the R plane, if starting below it.
+    pl_data->condition |= PL_COND_FLAG_RAPID_MOTION;
+    if (position[Z_AXIS] < cycle->r_plane) {
+      position[Z_AXIS] = cycle->r_plane;
+      mc_line(position, pl_data);
+    }
+
+    uint8_t hole;
+    for (hole = 0; hole < cycle->repeats; hole++) {
+      if (hole) {
+        target[X_AXIS] += hole_step[X_AXIS];
+        target[Y_AXIS] += hole_step[Y_AXIS];
+      }
+      position[X_AXIS] = target[X_AXIS];
+      position[Y_AXIS] = target[Y_AXIS];
+      mc_line(position, pl_data);
+      position[Z_AXIS] = cycle->r_plane;
+      mc_line(position, pl_data);
+
+      float depth = cycle->r_plane;
+      for (;;) {
+        if ((cycle->cycle == MOTION_MODE_PECK_DRILL) || (cycle->cycle == MOTION_MODE_CHIP_BREAK_DRILL)) {
+          depth -= cycle->peck;
+          if (depth < cycle->bottom) { depth = cycle->bottom; }
+        } else {
+          depth = cycle->bottom;
+        }
+        pl_data->condition &= ~PL_COND_FLAG_RAPID_MOTION;
+        position[Z_AXIS] = depth;
+        mc_line(position, pl_data);
+        pl_data->condition |= PL_COND_FLAG_RAPID_MOTION;
+        if (depth == cycle->bottom) { break; }
+
+        if (cycle->cycle == MOTION_MODE_PECK_DRILL) {
+          position[Z_AXIS] = cycle->r_plane;
+          mc_line(position, pl_data);
+        }
+        position[Z_AXIS] = min(depth + CANNED_CYCLE_PECK_CLEARANCE, cycle->r_plane);
+        mc_line(position, pl_data);
+
+        // Bail mid-hole on system abort. Runtime command check already performed by mc_line.
+        if (sys.abort) { return; }
+      }
+
+      if (cycle->cycle == MOTION_MODE_DWELL_DRILL) { mc_buffer_dwell(cycle->dwell, pl_data); }
+      position[Z_AXIS] = cycle->clear;
+      mc_line(position, pl_data);
+
+      if (sys.abort) { return; }
+    }
+    target[Z_AXIS] = cycle->clear;
+  }
+#endif
+
+
+// Execute dwell in seconds. With planned dwells, pl_data sets the spindle and coolant state held
+// during the dwell.
+void mc_dwell(float seconds, plan_line_data_t *pl_data)
 {
   if (sys.state == STATE_CHECK_MODE) { return; }
+  #ifdef PLANNED_DWELL
+    if (seconds > 0.0) {
+      mc_buffer_dwell(seconds, pl_data);
+      return;
+    }
+  #endif
   protocol_buffer_synchronize();
   delay_sec(seconds, DELAY_MODE_DWELL);
 }
@@ -226,13 +648,18 @@ void mc_homing_cycle(uint8_t cycle_mask)
     else
   #endif
   {
-    // Search to engage all axes limit switches at faster homing seek rate.
-    limits_go_home(HOMING_CYCLE_0);  // Homing cycle 0
-    #ifdef HOMING_CYCLE_1
-      limits_go_home(HOMING_CYCLE_1);  // Homing cycle 1
-    #endif
-    #ifdef HOMING_CYCLE_2
-      limits_go_home(HOMING_CYCLE_2);  // Homing cycle 2
+    #ifdef HOMING_PARALLEL_AXES
+      // Home the axes of all homing cycles at once, each at its own homing rates.
+      limits_go_home(HOMING_CYCLE_PARALLEL);
+    #else
+      // Search to engage all axes limit switches at faster homing seek rate.
+      limits_go_home(HOMING_CYCLE_0);  // Homing cycle 0
+      #ifdef HOMING_CYCLE_1
+        limits_go_home(HOMING_CYCLE_1);  // Homing cycle 1
+      #endif
+      #ifdef HOMING_CYCLE_2
+        limits_go_home(HOMING_CYCLE_2);  // Homing cycle 2
+      #endif
     #endif
   }
 
@@ -318,6 +745,79 @@ uint8_t mc_probe_cycle(float *target, plan_line_data_t *pl_data, uint8_t parser_
 }
 
 
+#ifdef ENABLE_MESH_LEVELING
+  // Probes a new leveling mesh over the machine XY range {x0,y0}-{x1,y1}, passed in grid[] as
+  // {x0,y0,x1,y1,z_probe,z_retract,feed}. Each grid point is approached at the z_retract height and
+  // probed down toward z_probe at the feed rate, visiting the rows in alternating directions. Heights
+  // are stored in the mesh relative to the first point and printed when done. Compensation stays
+  // disabled until enabled with '$ME'. A failed probe alarms and restores the mesh stored in EEPROM.
+  // NOTE: The first motion retracts Z straight to z_retract from the current position.
+  uint8_t mc_probe_grid(float *grid)
+  {
+    if ((grid[2] <= grid[0]) || (grid[3] <= grid[1]) || (grid[5] <= grid[4])) { return(STATUS_INVALID_STATEMENT); }
+    if (grid[6] <= 0.0) { return(STATUS_NEGATIVE_VALUE); }
+    float z_probe = grid[4];
+    float z_retract = grid[5];
+    float feed_rate = grid[6];
+
+    // Convert the XY range to the grid spacing. Defining the grid also disables compensation.
+    grid[2] = (grid[2]-grid[0])/(MESH_POINTS_X-1);
+    grid[3] = (grid[3]-grid[1])/(MESH_POINTS_Y-1);
+    mesh_set_grid(grid);
+
+    plan_line_data_t plan_data;
+    plan_line_data_t *pl_data = &plan_data;
+    memset(pl_data,0,sizeof(plan_line_data_t));
+    float target[N_AXIS];
+    plan_get_planner_mpos(target);
+
+    uint8_t row, idx, col;
+    for (row=0; row<MESH_POINTS_Y; row++) {
+      for (idx=0; idx<MESH_POINTS_X; idx++) {
+        col = (row & 0x01) ? (MESH_POINTS_X-1-idx) : idx;
+
+        // Retract and rapid over the grid point.
+        pl_data->condition = PL_COND_FLAG_RAPID_MOTION;
+        target[Z_AXIS] = z_retract;
+        mc_line(target, pl_data);
+        target[X_AXIS] = mesh.origin[X_AXIS] + col*mesh.spacing[X_AXIS];
+        target[Y_AXIS] = mesh.origin[Y_AXIS] + row*mesh.spacing[Y_AXIS];
+        mc_line(target, pl_data);
+
+        // Probe down. The probe cycle runs the queued rapids before it starts.
+        pl_data->condition = 0;
+        pl_data->feed_rate = feed_rate;
+        target[Z_AXIS] = z_probe;
+        if ((mc_probe_cycle(target, pl_data, 0) != GC_PROBE_FOUND) || sys.abort) {
+          mesh_init();
+          gc_sync_position();
+          return(STATUS_OK); // Alarm or reset already issued.
+        }
+        mesh.z[row][col] = system_convert_axis_steps_to_mpos(sys_probe_position, Z_AXIS);
+      }
+    }
+
+    // Retract from the last point and wait, so the mesh prints after all motion has completed.
+    pl_data->condition = PL_COND_FLAG_RAPID_MOTION;
+    target[Z_AXIS] = z_retract;
+    mc_line(target, pl_data);
+    protocol_buffer_synchronize();
+    if (sys.abort) {
+      mesh_init();
+      return(STATUS_OK);
+    }
+
+    float z_first = mesh.z[0][0];
+    for (row=0; row<MESH_POINTS_Y; row++) {
+      for (idx=0; idx<MESH_POINTS_X; idx++) { mesh.z[row][idx] -= z_first; }
+    }
+    gc_sync_position();
+    report_mesh();
+    return(STATUS_OK);
+  }
+#endif
+
+
 // Plans and executes the single special motion case for parking. Independent of main planner buffer.
 // NOTE: Uses the always free planner ring buffer head to store motion parameters for execution.
 #ifdef PARKING_ENABLE
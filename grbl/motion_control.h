@@ -28,6 +28,17 @@
 #define PARKING_MOTION_LINE_NUMBER 0
 
 #define HOMING_CYCLE_ALL  0  // Must be zero.
+
+#ifdef HOMING_PARALLEL_AXES
+  // Axes of all defined homing cycles, which are homed together.
+  #if defined(HOMING_CYCLE_2)
+    #define HOMING_CYCLE_PARALLEL (HOMING_CYCLE_0|HOMING_CYCLE_1|HOMING_CYCLE_2)
+  #elif defined(HOMING_CYCLE_1)
+    #define HOMING_CYCLE_PARALLEL (HOMING_CYCLE_0|HOMING_CYCLE_1)
+  #else
+    #define HOMING_CYCLE_PARALLEL HOMING_CYCLE_0
+  #endif
+#endif
 #define HOMING_CYCLE_X    bit(X_AXIS)
 #define HOMING_CYCLE_Y    bit(Y_AXIS)
 #define HOMING_CYCLE_Z    bit(Z_AXIS)
@@ -38,6 +49,11 @@
 // (1 minute)/feed_rate time.
 void mc_line(float *target, plan_line_data_t *pl_data);
 
+#ifdef INDEPENDENT_AXIS_RAPIDS
+// Execute a rapid with each axis at its own max rate. position == current xyz, target == target xyz.
+void mc_rapid(float *target, plan_line_data_t *pl_data, float *position);
+#endif
+
 // Execute an arc in offset mode format. position == current xyz, target == target xyz,
 // offset == offset from current xyz, axis_XXX defines circle plane in tool space, axis_linear is
 // the direction of helical travel, radius == circle radius, is_clockwise_arc boolean. Used
@@ -45,8 +61,34 @@ void mc_line(float *target, plan_line_data_t *pl_data);
 void mc_arc(float *target, plan_line_data_t *pl_data, float *position, float *offset, float radius,
   uint8_t axis_0, uint8_t axis_1, uint8_t axis_linear, uint8_t is_clockwise_arc);
 
+#ifdef ENABLE_G5_SPLINES
+// Execute a cubic spline in the XY plane. position == current xyz, target == target xyz,
+// first_offset == first control point offset from position, second_offset == second control
+// point offset from target.
+void mc_spline(float *target, plan_line_data_t *pl_data, float *position, float *first_offset,
+  float *second_offset);
+#endif
+
+#ifdef ENABLE_CANNED_CYCLES
+// Canned drilling cycle parameters. Heights are machine Z coordinates in mm.
+typedef struct {
+  float bottom;         // Hole bottom
+  float r_plane;        // Feeding starts at the R plane
+  float clear;          // Retract height after each hole. R plane with G99.
+  float peck;           // G73/G83 peck depth (mm)
+  float dwell;          // G82 dwell at the hole bottom (sec)
+  uint8_t cycle;        // Canned cycle motion mode
+  uint8_t repeats;      // Number of holes drilled. L word.
+  uint8_t incremental;  // Repeated holes are stepped by the XY travel of the block (G91).
+} mc_cycle_data_t;
+
+// Execute a canned drilling cycle. position == current xyz, target == first hole xy. Returns the
+// last hole at the retract height in target.
+void mc_canned_cycle(float *target, plan_line_data_t *pl_data, float *position, mc_cycle_data_t *cycle);
+#endif
+
 // Dwell for a specific number of seconds
-void mc_dwell(float seconds);
+void mc_dwell(float seconds, plan_line_data_t *pl_data);
 
 // Perform homing cycle to locate machine zero. Requires limit switches.
 void mc_homing_cycle(uint8_t cycle_mask);
@@ -54,6 +96,23 @@ void mc_homing_cycle(uint8_t cycle_mask);
 // Perform tool length probe cycle. Requires probe switch.
 uint8_t mc_probe_cycle(float *target, plan_line_data_t *pl_data, uint8_t parser_flags);
 
+#ifdef ENABLE_MESH_LEVELING
+  // Probes every point of a new leveling mesh grid and stores the heights in the mesh.
+  uint8_t mc_probe_grid(float *grid);
+#endif
+
+#ifdef PARSE_AHEAD_QUEUE
+  // Moves queued line motions into the planner buffer, while it has room. Returns true, if motions
+  // remain queued. Does nothing and returns false, when called from a buffer sync during a drain.
+  uint8_t mc_queue_drain();
+
+  // Waits until all queued line motions are in the planner buffer.
+  void mc_queue_flush();
+
+  // Discards all queued line motions. Called on system reset.
+  void mc_queue_reset();
+#endif
+
 // Handles updating the override control state.
 void mc_override_ctrl_update(uint8_t override_state);
 
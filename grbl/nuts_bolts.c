@@ -24,6 +24,9 @@
 
 #define MAX_INT_DIGITS 8 // Maximum number of digits in int32 (and float)
 
+// Powers of ten 1E1 to 1E8 for read_float(). All are exactly representable as floats.
+static const float float_pow10[MAX_INT_DIGITS] PROGMEM = { 1E1, 1E2, 1E3, 1E4, 1E5, 1E6, 1E7, 1E8 };
+
 
 // Extracts a floating point value from a string. The following code is based loosely on
 // the avr-libc strtod() function by Michael Stumpf and Dmitry Xmelkov and many freely
@@ -34,19 +37,18 @@
 // NOTE: Thanks to Radu-Eosif Mihailescu for identifying the issues with using strtod().
 uint8_t read_float(char *line, uint8_t *char_counter, float *float_ptr)
 {
-  char *ptr = line + *char_counter;
+  uint8_t idx = *char_counter;
   unsigned char c;
 
-  // Grab first character and increment pointer. No spaces assumed in line.
-  c = *ptr++;
+  // Grab first character. No spaces assumed in line.
+  c = line[idx];
 
   // Capture initial positive/minus character
   bool isnegative = false;
-  if (c == '-') {
-    isnegative = true;
-    c = *ptr++;
-  } else if (c == '+') {
-    c = *ptr++;
+  if ((c == '-') || (c == '+')) {
+    isnegative = (c == '-');
+    line_advance(idx);
+    c = line[idx];
   }
 
   // Extract number into fast integer. Track decimal in terms of exponent value.
@@ -69,7 +71,8 @@ uint8_t read_float(char *line, uint8_t *char_counter, float *float_ptr)
     } else {
       break;
     }
-    c = *ptr++;
+    line_advance(idx);
+    c = line[idx];
   }
 
   // Return if no digits have been read.
@@ -79,15 +82,13 @@ uint8_t read_float(char *line, uint8_t *char_counter, float *float_ptr)
   float fval;
   fval = (float)intval;
 
-  // Apply decimal. Should perform no more than two floating point multiplications for the
-  // expected range of E0 to E-4.
+  // Apply decimal. Divides once by an exact power of ten, rather than multiplying by the inexact
+  // 0.1 and 0.01, so values with up to 7 significant digits are correctly rounded. A multiply by
+  // the rounded reciprocal is one ulp off for up to 60% of these. Decimal digits are dropped past
+  // MAX_INT_DIGITS, which bounds the exponent to the table.
   if (fval != 0) {
-    while (exp <= -2) {
-      fval *= 0.01;
-      exp += 2;
-    }
     if (exp < 0) {
-      fval *= 0.1;
+      fval /= pgm_read_float(&float_pow10[-exp-1]);
     } else if (exp > 0) {
       do {
         fval *= 10.0;
@@ -102,7 +103,7 @@ uint8_t read_float(char *line, uint8_t *char_counter, float *float_ptr)
     *float_ptr = fval;
   }
 
-  *char_counter = ptr - line - 1; // Set char_counter to next statement
+  *char_counter = idx; // Set char_counter to next statement
 
   return(true);
 }
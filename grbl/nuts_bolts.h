@@ -64,6 +64,13 @@
 #define bit_istrue(x,mask) ((x & mask) != 0)
 #define bit_isfalse(x,mask) ((x & mask) == 0)
 
+// Advances a line index. Lines parsed in place in the serial RX buffer wrap at its end.
+#ifdef RX_BUFFER_LINE_PARSING
+  #define line_advance(idx) { if (++(idx) == RX_RING_BUFFER) { (idx) = 0; } }
+#else
+  #define line_advance(idx) (idx)++
+#endif
+
 // Read a floating point value from a string. Line points to the input buffer, char_counter
 // is the indexer pointing to the current character of the line, while float_ptr is
 // a pointer to the result variable. Returns true when it succeeds
@@ -39,6 +39,11 @@ typedef struct {
 } planner_t;
 static planner_t pl;
 
+#ifdef ENABLE_BACKLASH_COMPENSATION
+  static uint8_t backlash_dir_mask; // Axes last moved in the negative direction, by axis index bit.
+  static uint8_t backlash_block;    // Flags the block being planned as a compensation block.
+#endif
+
 
 // Returns the index of the next block in the ring buffer. Also called by stepper segment buffer.
 uint8_t plan_next_block_index(uint8_t block_index)
@@ -250,6 +255,10 @@ float plan_get_exec_block_exit_speed_sqr()
 uint8_t plan_check_full_buffer()
 {
   if (block_buffer_tail == next_buffer_head) { return(true); }
+  #ifdef ENABLE_BACKLASH_COMPENSATION
+    // Keep room for a compensation block queued ahead of the line.
+    if (block_buffer_tail == plan_next_block_index(next_buffer_head)) { return(true); }
+  #endif
   return(false);
 }
 
@@ -314,10 +323,48 @@ void plan_update_velocity_profile_parameters()
    to execute the special system motion. */
 uint8_t plan_buffer_line(float *target, plan_line_data_t *pl_data)
 {
+  uint8_t idx;
+
+  #ifdef ENABLE_BACKLASH_COMPENSATION
+    // Queue a compensation block first, if the line reverses any axis with backlash. It moves the
+    // reversing axes by their backlash at the rapid rate from the planner position, which it keeps.
+    if (!backlash_block && !(pl_data->condition & PL_COND_FLAG_SYSTEM_MOTION)) {
+      float backlash_target[N_AXIS];
+      uint8_t is_reversal = false;
+      for (idx=0; idx<N_AXIS; idx++) {
+        int32_t delta_steps = lround(target[idx]*settings.steps_per_mm[idx]) - pl.position[idx];
+        backlash_target[idx] = pl.position[idx]/settings.steps_per_mm[idx];
+        if (delta_steps == 0) { continue; }
+        if ((delta_steps < 0) != bit_istrue(backlash_dir_mask,bit(idx))) {
+          backlash_dir_mask ^= bit(idx);
+          if (settings.backlash[idx] > 0.0) {
+            is_reversal = true;
+            if (delta_steps < 0) { backlash_target[idx] -= settings.backlash[idx]; }
+            else { backlash_target[idx] += settings.backlash[idx]; }
+          }
+        }
+      }
+      if (is_reversal) {
+        plan_line_data_t backlash_data;
+        memcpy(&backlash_data, pl_data, sizeof(plan_line_data_t));
+        backlash_data.condition = (pl_data->condition & ~PL_COND_FLAG_INVERSE_TIME) | PL_COND_FLAG_RAPID_MOTION;
+        #ifdef VARIABLE_SPINDLE
+          if (settings.flags & BITFLAG_LASER_MODE) { backlash_data.spindle_speed = 0.0; }
+        #endif
+        backlash_block = true;
+        plan_buffer_line(backlash_target, &backlash_data);
+        backlash_block = false;
+      }
+    }
+  #endif
+
   // Prepare and initialize new block. Copy relevant pl_data for block execution.
   plan_block_t *block = &block_buffer[block_buffer_head];
   memset(block,0,sizeof(plan_block_t)); // Zero all block values.
   block->condition = pl_data->condition;
+  #ifdef ENABLE_BACKLASH_COMPENSATION
+    block->is_backlash = backlash_block;
+  #endif
   #ifdef VARIABLE_SPINDLE
     block->spindle_speed = pl_data->spindle_speed;
   #endif
@@ -328,7 +375,6 @@ uint8_t plan_buffer_line(float *target, plan_line_data_t *pl_data)
   // Compute and store initial move distance data.
   int32_t target_steps[N_AXIS], position_steps[N_AXIS];
   float unit_vec[N_AXIS], delta_mm;
-  uint8_t idx;
 
   // Copy position data based on type of motion being planned.
   if (block->condition & PL_COND_FLAG_SYSTEM_MOTION) { 
@@ -377,6 +423,41 @@ uint8_t plan_buffer_line(float *target, plan_line_data_t *pl_data)
     if (delta_mm < 0.0 ) { block->direction_bits |= get_direction_pin_mask(idx); }
   }
 
+  #ifdef NATIVE_ARC_BLOCKS
+    float exit_unit_vec[N_AXIS];
+    if (pl_data->arc != NULL) {
+      // Native arc. A full circle has no net steps, so the arc length decides an empty block.
+      plan_arc_data_t *arc = pl_data->arc;
+      block->is_arc = true;
+      memcpy(&block->arc, arc, sizeof(plan_arc_data_t));
+      float arc_mm = arc->radius*arc->angular_travel; // Signed arc length in the arc plane
+      block->millimeters = hypot_f(arc_mm, arc->linear_travel);
+      if (block->millimeters == 0.0) { return(PLAN_EMPTY_BLOCK); }
+
+      // Junctions are planned with the arc tangents at the start and end points. The arc direction
+      // sweeps through the plane, so the rate and acceleration limits assume the worst case direction.
+      float arc_end = arc->angle_start+arc->angular_travel;
+      arc_mm /= block->millimeters;
+      unit_vec[arc->axis_0] = -arc_mm*sin(arc->angle_start);
+      unit_vec[arc->axis_1] = arc_mm*cos(arc->angle_start);
+      unit_vec[arc->axis_linear] = arc->linear_travel/block->millimeters;
+      memcpy(exit_unit_vec, unit_vec, sizeof(unit_vec));
+      exit_unit_vec[arc->axis_0] = -arc_mm*sin(arc_end);
+      exit_unit_vec[arc->axis_1] = arc_mm*cos(arc_end);
+
+      float limit_vec[N_AXIS];
+      memcpy(limit_vec, unit_vec, sizeof(unit_vec));
+      limit_vec[arc->axis_0] = limit_vec[arc->axis_1] = arc_mm;
+      block->acceleration = limit_value_by_axis_maximum(settings.acceleration, limit_vec);
+      block->rapid_rate = limit_value_by_axis_maximum(settings.max_rate, limit_vec);
+
+      // Limit the rate by centripetal acceleration about the path curvature, which is the curvature
+      // of the helix when there is linear travel. Replaces the chord junction speed limits.
+      float curvature = arc->radius*arc->angular_travel*arc->angular_travel/(block->millimeters*block->millimeters);
+      if (curvature > 0.0) { block->rapid_rate = min(block->rapid_rate, sqrt(block->acceleration/curvature)); }
+    } else {
+  #endif
+
   // Bail if this is a zero-length block. Highly unlikely to occur.
   if (block->step_event_count == 0) { return(PLAN_EMPTY_BLOCK); }
 
@@ -388,6 +469,11 @@ uint8_t plan_buffer_line(float *target, plan_line_data_t *pl_data)
   block->acceleration = limit_value_by_axis_maximum(settings.acceleration, unit_vec);
   block->rapid_rate = limit_value_by_axis_maximum(settings.max_rate, unit_vec);
 
+  #ifdef NATIVE_ARC_BLOCKS
+      memcpy(exit_unit_vec, unit_vec, sizeof(unit_vec));
+    }
+  #endif
+
   // Store programmed rate.
   if (block->condition & PL_COND_FLAG_RAPID_MOTION) { block->programmed_rate = block->rapid_rate; }
   else { 
@@ -458,8 +544,20 @@ uint8_t plan_buffer_line(float *target, plan_line_data_t *pl_data)
     pl.previous_nominal_speed = nominal_speed;
     
     // Update previous path unit_vector and planner position.
-    memcpy(pl.previous_unit_vec, unit_vec, sizeof(unit_vec)); // pl.previous_unit_vec[] = unit_vec[]
-    memcpy(pl.position, target_steps, sizeof(target_steps)); // pl.position[] = target_steps[]
+    #ifdef NATIVE_ARC_BLOCKS
+      memcpy(pl.previous_unit_vec, exit_unit_vec, sizeof(exit_unit_vec)); // Arc end point tangent
+    #else
+      memcpy(pl.previous_unit_vec, unit_vec, sizeof(unit_vec)); // pl.previous_unit_vec[] = unit_vec[]
+    #endif
+    #ifdef ENABLE_BACKLASH_COMPENSATION
+      if (!block->is_backlash) { memcpy(pl.position, target_steps, sizeof(target_steps)); }
+    #else
+      memcpy(pl.position, target_steps, sizeof(target_steps)); // pl.position[] = target_steps[]
+    #endif
+
+    #ifdef PLANNED_ACCESSORY_STATE
+      sys.accessory_pending = false; // Block carries the current spindle and coolant state.
+    #endif
 
     // New block is all set. Update buffer head and next buffer head indices.
     block_buffer_head = next_buffer_head;
@@ -472,7 +570,47 @@ uint8_t plan_buffer_line(float *target, plan_line_data_t *pl_data)
 }
 
 
+#ifdef PLAN_DWELL_BLOCKS
+  /* Add a dwell block to the buffer. The block has no steps or distance, so the planner passes
+     plan the motions on both sides of it to a stop. The step segment generator then times it as
+     idle segments, while the following motions are planned and queued behind it.
+     NOTE: Assumes buffer is available, as with plan_buffer_line(). */
+  void plan_buffer_dwell(uint16_t dwell_ms, plan_line_data_t *pl_data)
+  {
+    plan_block_t *block = &block_buffer[block_buffer_head];
+    memset(block,0,sizeof(plan_block_t)); // Zero all block values. Entry and junction speeds are zero.
+    block->condition = pl_data->condition;
+    #ifdef VARIABLE_SPINDLE
+      block->spindle_speed = pl_data->spindle_speed;
+    #endif
+    #ifdef USE_LINE_NUMBERS
+      block->line_number = pl_data->line_number;
+    #endif
+    block->dwell_ms = dwell_ms;
+    block->acceleration = SOME_LARGE_VALUE; // Not used. Keeps the segment generator profile finite.
+
+    pl.previous_nominal_speed = 0.0; // Plan the next motion from a stop.
+    #ifdef PLANNED_ACCESSORY_STATE
+      sys.accessory_pending = false;
+    #endif
+
+    block_buffer_head = next_buffer_head;
+    next_buffer_head = plan_next_block_index(block_buffer_head);
+    planner_recalculate();
+  }
+#endif
+
+
 // Reset the planner position vectors. Called by the system abort/initialization routine.
+#ifdef ENABLE_BACKLASH_COMPENSATION
+  void plan_reset_backlash(uint8_t cycle_mask)
+  {
+    // Homing pulls off in the positive direction when the homing direction bit is set.
+    backlash_dir_mask = (backlash_dir_mask & ~cycle_mask) | (~settings.homing_dir_mask & cycle_mask);
+  }
+#endif
+
+
 void plan_sync_position()
 {
   // TODO: For motor configurations not in the same coordinate frame as the machine position,
@@ -494,6 +632,14 @@ void plan_sync_position()
 }
 
 
+// Returns the end position of the last queued planner block in machine coordinates (mm).
+void plan_get_planner_mpos(float *target)
+{
+  uint8_t idx;
+  for (idx=0; idx<N_AXIS; idx++) { target[idx] = pl.position[idx]/settings.steps_per_mm[idx]; }
+}
+
+
 // Returns the number of available blocks are in the planner buffer.
 uint8_t plan_get_block_buffer_available()
 {
@@ -511,6 +657,21 @@ uint8_t plan_get_block_buffer_count()
 }
 
 
+#ifdef DEFERRED_CYCLE_START
+  // Returns the total distance of the blocks in the planner buffer. Called while idle only.
+  float plan_get_block_buffer_distance()
+  {
+    float distance = 0.0;
+    uint8_t block_index = block_buffer_tail;
+    while (block_index != block_buffer_head) {
+      distance += block_buffer[block_index].millimeters;
+      block_index = plan_next_block_index(block_index);
+    }
+    return(distance);
+  }
+#endif
+
+
 // Re-initialize buffer plan with a partially completed block, assumed to exist at the buffer tail.
 // Called after a steppers have come to a complete stop for a feed hold and the cycle is stopped.
 void plan_cycle_reinitialize()
@@ -22,6 +22,10 @@
 #ifndef planner_h
 #define planner_h
 
+// Dwells are queued as timed blocks by G4 and the canned drilling cycles.
+#if defined(PLANNED_DWELL) || defined(ENABLE_CANNED_CYCLES)
+  #define PLAN_DWELL_BLOCKS
+#endif
 
 // The number of linear motions that can be in the plan at any give time
 #ifndef BLOCK_BUFFER_SIZE
@@ -50,6 +54,20 @@
 #define PL_COND_ACCESSORY_MASK (PL_COND_FLAG_SPINDLE_CW|PL_COND_FLAG_SPINDLE_CCW|PL_COND_FLAG_COOLANT_FLOOD|PL_COND_FLAG_COOLANT_MIST)
 
 
+#ifdef NATIVE_ARC_BLOCKS
+  // Geometry of a native arc block. Angles are about the arc center in the arc plane.
+  typedef struct {
+    float radius;          // Arc radius (mm)
+    float angle_start;     // Angle of the start point (rad)
+    float angular_travel;  // Signed angular span. Positive is CCW. (rad)
+    float linear_travel;   // Helical axis travel (mm)
+    uint8_t axis_0;        // Arc plane axes and helical axis
+    uint8_t axis_1;
+    uint8_t axis_linear;
+  } plan_arc_data_t;
+#endif
+
+
 // This struct stores a linear movement of a g-code block motion with its critical "nominal" values
 // are as specified in the source g-code.
 typedef struct {
@@ -83,6 +101,21 @@ typedef struct {
     // Stored spindle speed data used by spindle overrides and resuming methods.
     float spindle_speed;    // Block spindle speed. Copied from pl_line_data.
   #endif
+
+  #ifdef ENABLE_BACKLASH_COMPENSATION
+    uint8_t is_backlash; // Compensation block. Its steps do not move the machine position.
+  #endif
+
+  #ifdef NATIVE_ARC_BLOCKS
+    // Arc blocks are traced by the step segment generator. Steps and direction bits then hold the
+    // net move to the arc end point, not a line to be executed.
+    uint8_t is_arc;
+    plan_arc_data_t arc;
+  #endif
+
+  #ifdef PLAN_DWELL_BLOCKS
+    uint16_t dwell_ms;      // Remaining time of a dwell block without motion. Zero for motion blocks.
+  #endif
 } plan_block_t;
 
 
@@ -94,6 +127,9 @@ typedef struct {
   #ifdef USE_LINE_NUMBERS
     int32_t line_number;    // Desired line number to report when executing.
   #endif
+  #ifdef NATIVE_ARC_BLOCKS
+    plan_arc_data_t *arc;   // Arc geometry, if the motion is a native arc. NULL for line motions.
+  #endif
 } plan_line_data_t;
 
 
@@ -106,6 +142,17 @@ void plan_reset_buffer(); // Reset buffer only.
 // rate is taken to mean "frequency" and would complete the operation in 1/feed_rate minutes.
 uint8_t plan_buffer_line(float *target, plan_line_data_t *pl_data);
 
+#ifdef PLAN_DWELL_BLOCKS
+  // Add a dwell of dwell_ms milliseconds to the buffer. Motions are planned to a stop before and after
+  // the dwell, which the step segment generator executes as idle time.
+  void plan_buffer_dwell(uint16_t dwell_ms, plan_line_data_t *pl_data);
+#endif
+
+#ifdef ENABLE_BACKLASH_COMPENSATION
+  // Sets the backlash direction state of the axes in cycle_mask to their homing pull-off direction.
+  void plan_reset_backlash(uint8_t cycle_mask);
+#endif
+
 // Called when the current block is no longer needed. Discards the block and makes the memory
 // availible for new blocks.
 void plan_discard_current_block();
@@ -141,9 +188,15 @@ uint8_t plan_get_block_buffer_available();
 // NOTE: Deprecated. Not used unless classic status reports are enabled in config.h
 uint8_t plan_get_block_buffer_count();
 
+#ifdef DEFERRED_CYCLE_START
+  // Returns the total distance of the blocks in the planner buffer.
+  float plan_get_block_buffer_distance();
+#endif
+
 // Returns the status of the block ring buffer. True, if buffer is full.
 uint8_t plan_check_full_buffer();
 
+// Returns the end position of the last queued block in machine coordinates.
 void plan_get_planner_mpos(float *target);
 
 
@@ -32,6 +32,72 @@ static char line[LINE_BUFFER_SIZE]; // Line to be executed. Zero-terminated.
 static void protocol_exec_rt_suspend();
 
 
+#ifdef ENABLE_PROGRAM_MODE
+  // Returns true, if the line starting at index char_counter is only a '%' program delimiter.
+  static uint8_t protocol_is_program_delimiter(char *line, uint8_t char_counter)
+  {
+    if (line[char_counter] != '%') { return(false); }
+    line_advance(char_counter);
+    return(line[char_counter] == 0);
+  }
+
+
+  // Starts or ends a program. The end starts the cycle for the blocks still waiting in the buffer.
+  static void protocol_program_delimiter()
+  {
+    sys.program_running = !sys.program_running;
+    if (!sys.program_running) { protocol_auto_cycle_start(); }
+  }
+#endif
+
+
+#ifdef DEFERRED_CYCLE_START
+  // Returns true, if a line is waiting to be read and queued. With line parsing, the RX buffer also
+  // holds the characters of a line still being received, which may never become a motion.
+  static uint8_t protocol_input_pending()
+  {
+    #ifdef RX_BUFFER_LINE_PARSING
+      return(serial_get_line() != SERIAL_NO_DATA);
+    #else
+      return(serial_get_rx_buffer_count() != 0);
+    #endif
+  }
+#endif
+
+
+#if defined(ENABLE_PROGRAM_MODE) || defined(DEFERRED_CYCLE_START)
+  // Auto-cycle start, when the main loop has emptied the serial read buffer.
+  static void protocol_idle_cycle_start()
+  {
+    #ifdef ENABLE_PROGRAM_MODE
+      // A running program has more lines coming. Wait for a full buffer, a sync or the program end.
+      if (sys.program_running) { return; }
+    #endif
+    #ifdef DEFERRED_CYCLE_START
+      // Wait for the start threshold, while more data arrives within the timeout. A single block
+      // with nothing more received is a command sent by hand. Once running, or in any other state,
+      // start as before.
+      if ((sys.state == STATE_IDLE) && (plan_get_current_block() != NULL)) {
+        uint8_t block_count = plan_get_block_buffer_count();
+        if ((block_count < DEFERRED_START_BLOCKS) &&
+            (plan_get_block_buffer_distance() < DEFERRED_START_DISTANCE) &&
+            ((block_count > 1) || protocol_input_pending())) {
+          uint8_t timeout = DEFERRED_START_TIMEOUT;
+          do {
+            if (protocol_input_pending()) { return; } // Read and queue the next line first.
+            delay_ms(1);
+            protocol_execute_realtime(); // Check for any run-time commands
+            if (sys.abort) { return; } // Bail, if system abort.
+            if (sys.state != STATE_IDLE) { return; } // Started or stopped by a run-time command.
+          } while (--timeout);
+        }
+      }
+    #endif
+    protocol_auto_cycle_start();
+  }
+#endif
+
+
 /*
   GRBL PRIMARY LOOP:
 */
@@ -68,93 +134,188 @@ void protocol_main_loop()
   // This is also where Grbl idles while waiting for something to do.
   // ---------------------------------------------------------------------------------
 
-  uint8_t line_flags = 0;
+  #ifndef RX_BUFFER_LINE_PARSING
+    uint8_t line_flags = 0;
+  #endif
   uint8_t char_counter = 0;
   uint8_t c;
   for (;;) {
 
-    // Process one line of incoming serial data, as the data becomes available. Performs an
-    // initial filtering by removing spaces and comments and capitalizing all letters.
-    while((c = serial_read()) != SERIAL_NO_DATA) {
-      if ((c == '\n') || (c == '\r')) { // End of line reached
+    #ifdef RX_BUFFER_LINE_PARSING
+      // Execute each complete line in place in the serial read buffer. The serial receive
+      // interrupt has already removed spaces and comments and capitalized all letters.
+      while ((char_counter = serial_get_line()) != SERIAL_NO_DATA) {
 
         protocol_execute_realtime(); // Runtime command check point.
         if (sys.abort) { return; } // Bail to calling function upon system abort
-
-        line[char_counter] = 0; // Set string termination character.
-        #ifdef REPORT_ECHO_LINE_RECEIVED
-          report_echo_line_received(line);
+        #ifdef PARSE_AHEAD_QUEUE
+          mc_queue_drain(); // Refill the planner buffer, before parsing ahead again.
         #endif
 
-        // Direct and execute one line of formatted input, and report status of execution.
-        if (line_flags & LINE_FLAG_OVERFLOW) {
+        c = serial_rx_buffer[char_counter];
+        if (c == SERIAL_LINE_OVERFLOW) {
           // Report line overflow error.
           report_status_message(STATUS_OVERFLOW);
-        } else if (line[0] == 0) {
+        } else if (c == 0) {
           // Empty or comment line. For syncing purposes.
           report_status_message(STATUS_OK);
-        } else if (line[0] == '$') {
-          // Grbl '$' system command
-          report_status_message(system_execute_line(line));
+        } else if (c == '$') {
+          // Grbl '$' system command. Copied into the line buffer, since some are stored as strings.
+          uint8_t line_length = 0;
+          while ((c = serial_rx_buffer[char_counter]) != 0) {
+            if (line_length >= (LINE_BUFFER_SIZE-1)) { break; }
+            line[line_length++] = c;
+            line_advance(char_counter);
+          }
+          line[line_length] = 0;
+          if (c) { report_status_message(STATUS_OVERFLOW); }
+          else { report_status_message(system_execute_line(line)); }
         } else if (sys.state & (STATE_ALARM | STATE_JOG)) {
           // Everything else is gcode. Block if in alarm or jog mode.
           report_status_message(STATUS_SYSTEM_GC_LOCK);
+        #ifdef ENABLE_PROGRAM_MODE
+          } else if (protocol_is_program_delimiter((char*)serial_rx_buffer, char_counter)) {
+            protocol_program_delimiter();
+            report_status_message(STATUS_OK);
+        #endif
         } else {
           // Parse and execute g-code block.
-          report_status_message(gc_execute_line(line));
+          #ifdef ENABLE_SUBPROGRAMS
+            report_status_message(subprogram_execute_line((char*)serial_rx_buffer, char_counter));
+          #else
+            report_status_message(gc_execute_line((char*)serial_rx_buffer, char_counter));
+          #endif
         }
+        serial_release_line();
+      }
+    #else
+      // Process one line of incoming serial data, as the data becomes available. Performs an
+      // initial filtering by removing spaces and comments and capitalizing all letters.
+      while((c = serial_read()) != SERIAL_NO_DATA) {
+        #ifdef ENABLE_BINARY_PROTOCOL
+          if (sys.binary_mode) {
+            if (binary_read(c)) { // End of frame reached
+              protocol_execute_realtime(); // Runtime command check point.
+              if (sys.abort) { return; } // Bail to calling function upon system abort
+              #ifdef PARSE_AHEAD_QUEUE
+                mc_queue_drain(); // Refill the planner buffer, before parsing ahead again.
+              #endif
+              if (sys.state & (STATE_ALARM | STATE_JOG)) {
+                binary_execute_frame(); // Discard the record. Block motions, as for g-code.
+                report_status_message(STATUS_SYSTEM_GC_LOCK);
+              } else {
+                report_status_message(binary_execute_frame());
+              }
+            }
+            continue;
+          } else if (c == CMD_BINARY_MODE) {
+            // Switch at this point of the stream. Any partial line before it is discarded.
+            line_flags = 0;
+            char_counter = 0;
+            binary_start();
+            report_status_message(STATUS_OK);
+            continue;
+          }
+        #endif
+        if ((c == '\n') || (c == '\r')) { // End of line reached
 
-        // Reset tracking data for next line.
-        line_flags = 0;
-        char_counter = 0;
+          protocol_execute_realtime(); // Runtime command check point.
+          if (sys.abort) { return; } // Bail to calling function upon system abort
+          #ifdef PARSE_AHEAD_QUEUE
+            mc_queue_drain(); // Refill the planner buffer, before parsing ahead again.
+          #endif
 
-      } else {
+          line[char_counter] = 0; // Set string termination character.
+          #ifdef REPORT_ECHO_LINE_RECEIVED
+            report_echo_line_received(line);
+          #endif
 
-        if (line_flags) {
-          // Throw away all (except EOL) comment characters and overflow characters.
-          if (c == ')') {
-            // End of '()' comment. Resume line allowed.
-            if (line_flags & LINE_FLAG_COMMENT_PARENTHESES) { line_flags &= ~(LINE_FLAG_COMMENT_PARENTHESES); }
+          // Direct and execute one line of formatted input, and report status of execution.
+          if (line_flags & LINE_FLAG_OVERFLOW) {
+            // Report line overflow error.
+            report_status_message(STATUS_OVERFLOW);
+          } else if (line[0] == 0) {
+            // Empty or comment line. For syncing purposes.
+            report_status_message(STATUS_OK);
+          } else if (line[0] == '$') {
+            // Grbl '$' system command
+            report_status_message(system_execute_line(line));
+          } else if (sys.state & (STATE_ALARM | STATE_JOG)) {
+            // Everything else is gcode. Block if in alarm or jog mode.
+            report_status_message(STATUS_SYSTEM_GC_LOCK);
+          #ifdef ENABLE_PROGRAM_MODE
+            } else if (protocol_is_program_delimiter(line, 0)) {
+              protocol_program_delimiter();
+              report_status_message(STATUS_OK);
+          #endif
+          } else {
+            // Parse and execute g-code block.
+            #ifdef ENABLE_SUBPROGRAMS
+              report_status_message(subprogram_execute_line(line, 0));
+            #else
+              report_status_message(gc_execute_line(line, 0));
+            #endif
           }
+
+          // Reset tracking data for next line.
+          line_flags = 0;
+          char_counter = 0;
+
         } else {
-          if (c <= ' ') {
-            // Throw away whitepace and control characters
-          } else if (c == '/') {
-            // Block delete NOT SUPPORTED. Ignore character.
-            // NOTE: If supported, would simply need to check the system if block delete is enabled.
-          } else if (c == '(') {
-            // Enable comments flag and ignore all characters until ')' or EOL.
-            // NOTE: This doesn't follow the NIST definition exactly, but is good enough for now.
-            // In the future, we could simply remove the items within the comments, but retain the
-            // comment control characters, so that the g-code parser can error-check it.
-            line_flags |= LINE_FLAG_COMMENT_PARENTHESES;
-          } else if (c == ';') {
-            // NOTE: ';' comment to EOL is a LinuxCNC definition. Not NIST.
-            line_flags |= LINE_FLAG_COMMENT_SEMICOLON;
-          // TODO: Install '%' feature
-          // } else if (c == '%') {
-            // Program start-end percent sign NOT SUPPORTED.
-            // NOTE: This maybe installed to tell Grbl when a program is running vs manual input,
-            // where, during a program, the system auto-cycle start will continue to execute
-            // everything until the next '%' sign. This will help fix resuming issues with certain
-            // functions that empty the planner buffer to execute its task on-time.
-          } else if (char_counter >= (LINE_BUFFER_SIZE-1)) {
-            // Detect line buffer overflow and set flag.
-            line_flags |= LINE_FLAG_OVERFLOW;
-          } else if (c >= 'a' && c <= 'z') { // Upcase lowercase
-            line[char_counter++] = c-'a'+'A';
+
+          if (line_flags) {
+            // Throw away all (except EOL) comment characters and overflow characters.
+            if (c == ')') {
+              // End of '()' comment. Resume line allowed.
+              if (line_flags & LINE_FLAG_COMMENT_PARENTHESES) { line_flags &= ~(LINE_FLAG_COMMENT_PARENTHESES); }
+            }
           } else {
-            line[char_counter++] = c;
+            if (c <= ' ') {
+              // Throw away whitepace and control characters
+            } else if (c == '/') {
+              // Block delete NOT SUPPORTED. Ignore character.
+              // NOTE: If supported, would simply need to check the system if block delete is enabled.
+            } else if (c == '(') {
+              // Enable comments flag and ignore all characters until ')' or EOL.
+              // NOTE: This doesn't follow the NIST definition exactly, but is good enough for now.
+              // In the future, we could simply remove the items within the comments, but retain the
+              // comment control characters, so that the g-code parser can error-check it.
+              line_flags |= LINE_FLAG_COMMENT_PARENTHESES;
+            } else if (c == ';') {
+              // NOTE: ';' comment to EOL is a LinuxCNC definition. Not NIST.
+              line_flags |= LINE_FLAG_COMMENT_SEMICOLON;
+            // TODO: Install '%' feature
+            // } else if (c == '%') {
+              // Program start-end percent sign NOT SUPPORTED.
+              // NOTE: This maybe installed to tell Grbl when a program is running vs manual input,
+              // where, during a program, the system auto-cycle start will continue to execute
+              // everything until the next '%' sign. This will help fix resuming issues with certain
+              // functions that empty the planner buffer to execute its task on-time.
+            } else if (char_counter >= (LINE_BUFFER_SIZE-1)) {
+              // Detect line buffer overflow and set flag.
+              line_flags |= LINE_FLAG_OVERFLOW;
+            } else if (c >= 'a' && c <= 'z') { // Upcase lowercase
+              line[char_counter++] = c-'a'+'A';
+            } else {
+              line[char_counter++] = c;
+            }
           }
-        }
 
+        }
       }
-    }
+    #endif
 
     // If there are no more characters in the serial read buffer to be processed and executed,
     // this indicates that g-code streaming has either filled the planner buffer or has
     // completed. In either case, auto-cycle start, if enabled, any queued moves.
-    protocol_auto_cycle_start();
+    #ifdef PARSE_AHEAD_QUEUE
+      mc_queue_drain(); // Move parsed motions into the planner buffer, as blocks complete.
+    #endif
+    #if defined(ENABLE_PROGRAM_MODE) || defined(DEFERRED_CYCLE_START)
+      protocol_idle_cycle_start();
+    #else
+      protocol_auto_cycle_start();
+    #endif
 
     protocol_execute_realtime();  // Runtime command check point.
     if (sys.abort) { return; } // Bail to main() program loop to reset system.
@@ -168,6 +329,9 @@ void protocol_main_loop()
 // during a synchronize call, if it should happen. Also, waits for clean cycle end.
 void protocol_buffer_synchronize()
 {
+  #ifdef PARSE_AHEAD_QUEUE
+    mc_queue_flush(); // Parsed motions not yet in the planner buffer are part of the sync.
+  #endif
   // If system is queued, ensure cycle resumes if the auto start flag is present.
   protocol_auto_cycle_start();
   do {
@@ -177,6 +341,38 @@ void protocol_buffer_synchronize()
 }
 
 
+#ifdef PLANNED_ACCESSORY_STATE
+  // Spindle and coolant changes are only applied immediately when no motion is queued or executing,
+  // or in laser mode, which syncs them as before. The pending flag is cleared by the planner, when a
+  // block carrying the change is queued.
+  uint8_t protocol_accessory_sync()
+  {
+    if (settings.flags & BITFLAG_LASER_MODE) {
+      protocol_buffer_synchronize();
+      return(true);
+    }
+    #ifdef PARSE_AHEAD_QUEUE
+      mc_queue_flush(); // Queued motions keep the old state and would clear the pending flag.
+    #endif
+    if ((sys.state == STATE_IDLE) && (plan_get_current_block() == NULL)) { return(true); }
+    sys.accessory_pending = true;
+    return(false);
+  }
+
+
+  // Applies the parser spindle and coolant state, if a change was left pending when the buffer emptied.
+  // A cycle may also stop with blocks left, which still precede the change, as after a motion cancel.
+  static void protocol_exec_accessory_pending()
+  {
+    if (sys.accessory_pending && (plan_get_current_block() == NULL)) {
+      sys.accessory_pending = false;
+      spindle_set_state(gc_state.modal.spindle, gc_state.spindle_speed);
+      coolant_set_state(gc_state.modal.coolant);
+    }
+  }
+#endif
+
+
 // Auto-cycle start triggers when there is a motion ready to execute and if the main program is not
 // actively parsing commands.
 // NOTE: This function is called from the main loop, buffer sync, and mc_line() only and executes
@@ -360,6 +556,9 @@ void protocol_exec_rt_system()
             } else { // Otherwise, do nothing. Set and resume IDLE state.
               sys.suspend = SUSPEND_DISABLE; // Break suspend state.
               sys.state = STATE_IDLE;
+              #ifdef PLANNED_ACCESSORY_STATE
+                protocol_exec_accessory_pending();
+              #endif
             }
           }
         }
@@ -396,6 +595,9 @@ void protocol_exec_rt_system()
         } else {
           sys.suspend = SUSPEND_DISABLE;
           sys.state = STATE_IDLE;
+          #ifdef PLANNED_ACCESSORY_STATE
+            protocol_exec_accessory_pending();
+          #endif
         }
       }
       system_clear_exec_state_flag(EXEC_CYCLE_STOP);
@@ -447,7 +649,16 @@ void protocol_exec_rt_system()
     if (last_s_override != sys.spindle_speed_ovr) {
       sys.spindle_speed_ovr = last_s_override;
       // NOTE: Spindle speed overrides during HOLD state are taken care of by suspend function.
-      if (sys.state == STATE_IDLE) { spindle_set_state(gc_state.modal.spindle, gc_state.spindle_speed); }
+      if (sys.state == STATE_IDLE) {
+        #ifdef PLANNED_ACCESSORY_STATE
+          // The parser may be ahead of blocks queued while idle. The first one carries the output state.
+          plan_block_t *block = plan_get_current_block();
+          if (block != NULL) { spindle_set_state((block->condition & PL_COND_SPINDLE_MASK), block->spindle_speed); }
+          else { spindle_set_state(gc_state.modal.spindle, gc_state.spindle_speed); }
+        #else
+          spindle_set_state(gc_state.modal.spindle, gc_state.spindle_speed);
+        #endif
+      }
 			else { bit_true(sys.step_control, STEP_CONTROL_UPDATE_SPINDLE_PWM); }
       sys.report_ovr_counter = 0; // Set to report change immediately
     }
@@ -462,11 +673,16 @@ void protocol_exec_rt_system()
     }
 
     // NOTE: Since coolant state always performs a planner sync whenever it changes, the current
-    // run state can be determined by checking the parser state.
+    // run state can be determined by checking the parser state. Planned accessory states are not
+    // synced, so the toggles start from the output state instead.
     // NOTE: Coolant overrides only operate during IDLE, CYCLE, HOLD, and JOG states. Ignored otherwise.
     if (rt_exec & (EXEC_COOLANT_FLOOD_OVR_TOGGLE | EXEC_COOLANT_MIST_OVR_TOGGLE)) {
       if ((sys.state == STATE_IDLE) || (sys.state & (STATE_CYCLE | STATE_HOLD | STATE_JOG))) {
-        uint8_t coolant_state = gc_state.modal.coolant;
+        #ifdef PLANNED_ACCESSORY_STATE
+          uint8_t coolant_state = coolant_get_state();
+        #else
+          uint8_t coolant_state = gc_state.modal.coolant;
+        #endif
         #ifdef ENABLE_M7
           if (rt_exec & EXEC_COOLANT_MIST_OVR_TOGGLE) {
             if (coolant_state & COOLANT_MIST_ENABLE) { bit_false(coolant_state,COOLANT_MIST_ENABLE); }
@@ -522,6 +738,8 @@ static void protocol_exec_rt_suspend()
     #endif
   #endif
 
+  // NOTE: Restores follow the executing block and the outputs, since the parser state may be ahead
+  // of them with planned accessory states.
   plan_block_t *block = plan_get_current_block();
   uint8_t restore_condition;
   #ifdef VARIABLE_SPINDLE
@@ -667,7 +885,7 @@ static void protocol_exec_rt_suspend()
             #endif
 
             // Delayed Tasks: Restart spindle and coolant, delay to power-up, then resume cycle.
-            if (gc_state.modal.spindle != SPINDLE_DISABLE) {
+            if (restore_condition & (PL_COND_FLAG_SPINDLE_CW | PL_COND_FLAG_SPINDLE_CCW)) {
               // Block if safety door re-opened during prior restore actions.
               if (bit_isfalse(sys.suspend,SUSPEND_RESTART_RETRACT)) {
                 if (bit_istrue(settings.flags,BITFLAG_LASER_MODE)) {
@@ -679,7 +897,7 @@ static void protocol_exec_rt_suspend()
                 }
               }
             }
-            if (gc_state.modal.coolant != COOLANT_DISABLE) {
+            if (restore_condition & (PL_COND_FLAG_COOLANT_FLOOD | PL_COND_FLAG_COOLANT_MIST)) {
               // Block if safety door re-opened during prior restore actions.
               if (bit_isfalse(sys.suspend,SUSPEND_RESTART_RETRACT)) {
                 // NOTE: Laser mode will honor this delay. An exhaust system is often controlled by this pin.
@@ -725,7 +943,7 @@ static void protocol_exec_rt_suspend()
         if (sys.spindle_stop_ovr) {
           // Handles beginning of spindle stop
           if (sys.spindle_stop_ovr & SPINDLE_STOP_OVR_INITIATE) {
-            if (gc_state.modal.spindle != SPINDLE_DISABLE) {
+            if (restore_condition & (PL_COND_FLAG_SPINDLE_CW | PL_COND_FLAG_SPINDLE_CCW)) {
               spindle_set_state(SPINDLE_DISABLE,0.0); // De-energize
               sys.spindle_stop_ovr = SPINDLE_STOP_OVR_ENABLED; // Set stop override state to enabled, if de-energized.
             } else {
@@ -733,7 +951,7 @@ static void protocol_exec_rt_suspend()
             }
           // Handles restoring of spindle state
           } else if (sys.spindle_stop_ovr & (SPINDLE_STOP_OVR_RESTORE | SPINDLE_STOP_OVR_RESTORE_CYCLE)) {
-            if (gc_state.modal.spindle != SPINDLE_DISABLE) {
+            if (restore_condition & (PL_COND_FLAG_SPINDLE_CW | PL_COND_FLAG_SPINDLE_CCW)) {
               report_feedback_message(MESSAGE_SPINDLE_RESTORE);
               if (bit_istrue(settings.flags,BITFLAG_LASER_MODE)) {
                 // When in laser mode, ignore spindle spin-up delay. Set to turn on laser when cycle starts.
@@ -46,4 +46,10 @@ void protocol_auto_cycle_start();
 // Block until all buffered steps are executed
 void protocol_buffer_synchronize();
 
+#ifdef PLANNED_ACCESSORY_STATE
+  // Returns true, if a parser spindle or coolant change is to be applied now. Otherwise, it is left
+  // to the stepper and applied with the next queued block.
+  uint8_t protocol_accessory_sync();
+#endif
+
 #endif
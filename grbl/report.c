@@ -84,6 +84,8 @@ static void report_util_setting_string(uint8_t n) {
         case 1: printPgmString(PSTR(":mm/min")); break;
         case 2: printPgmString(PSTR(":mm/s^2")); break;
         case 3: printPgmString(PSTR(":mm max")); break;
+        case 4: printPgmString(PSTR(":hm feed")); break;
+        case 5: printPgmString(PSTR(":hm seek")); break;
       }
       break;
   }
@@ -218,6 +220,13 @@ void report_grbl_settings() {
         case 1: report_util_float_setting(val+idx,settings.max_rate[idx],N_DECIMAL_SETTINGVALUE); break;
         case 2: report_util_float_setting(val+idx,settings.acceleration[idx]/(60*60),N_DECIMAL_SETTINGVALUE); break;
         case 3: report_util_float_setting(val+idx,-settings.max_travel[idx],N_DECIMAL_SETTINGVALUE); break;
+        #ifdef HOMING_PARALLEL_AXES
+          case 4: report_util_float_setting(val+idx,settings.homing_axis_feed_rate[idx],N_DECIMAL_SETTINGVALUE); break;
+          case 5: report_util_float_setting(val+idx,settings.homing_axis_seek_rate[idx],N_DECIMAL_SETTINGVALUE); break;
+        #endif
+        #ifdef ENABLE_BACKLASH_COMPENSATION
+          case 6: report_util_float_setting(val+idx,settings.backlash[idx],N_DECIMAL_SETTINGVALUE); break;
+        #endif
       }
     }
     val += AXIS_SETTINGS_INCREMENT;
@@ -234,6 +243,9 @@ void report_probe_parameters()
   printPgmString(PSTR("[PRB:"));
   float print_position[N_AXIS];
   system_convert_array_steps_to_mpos(print_position,sys_probe_position);
+  #ifdef ENABLE_MESH_LEVELING
+    mesh_remove_offset(print_position);
+  #endif
   report_util_axis_values(print_position);
   serial_write(':');
   print_uint8_base10(sys.probe_succeeded);
@@ -241,6 +253,36 @@ void report_probe_parameters()
 }
 
 
+#ifdef ENABLE_MESH_LEVELING
+  // Prints the leveling mesh grid origin, spacing and enable state, followed by one line of Z
+  // offsets per row of grid points along Y.
+  void report_mesh()
+  {
+    uint8_t idx;
+    printPgmString(PSTR("[MESH:"));
+    for (idx=0; idx<2; idx++) {
+      printFloat(mesh.origin[idx],N_DECIMAL_SETTINGVALUE);
+      serial_write(',');
+    }
+    printFloat(mesh.spacing[X_AXIS],N_DECIMAL_SETTINGVALUE);
+    serial_write(',');
+    printFloat(mesh.spacing[Y_AXIS],N_DECIMAL_SETTINGVALUE);
+    serial_write(':');
+    print_uint8_base10(mesh.enabled);
+    report_util_feedback_line_feed();
+    uint8_t row;
+    for (row=0; row<MESH_POINTS_Y; row++) {
+      printPgmString(PSTR("[MZ:"));
+      for (idx=0; idx<MESH_POINTS_X; idx++) {
+        if (idx) { serial_write(','); }
+        printFloat(mesh.z[row][idx],N_DECIMAL_SETTINGVALUE);
+      }
+      report_util_feedback_line_feed();
+    }
+  }
+#endif
+
+
 // Prints Grbl NGC parameters (coordinate offsets, probing)
 void report_ngc_parameters()
 {
@@ -278,6 +320,10 @@ void report_gcode_modes()
   if (gc_state.modal.motion >= MOTION_MODE_PROBE_TOWARD) {
     printPgmString(PSTR("38."));
     print_uint8_base10(gc_state.modal.motion - (MOTION_MODE_PROBE_TOWARD-2));
+  #ifdef ENABLE_G5_SPLINES
+  } else if (gc_state.modal.motion == MOTION_MODE_QUADRATIC_SPLINE) {
+    printPgmString(PSTR("5.1"));
+  #endif
   } else {
     print_uint8_base10(gc_state.modal.motion);
   }
@@ -297,6 +343,11 @@ void report_gcode_modes()
   report_util_gcode_modes_G();
   print_uint8_base10(94-gc_state.modal.feed_rate);
 
+  #ifdef ENABLE_CANNED_CYCLES
+    report_util_gcode_modes_G();
+    print_uint8_base10(gc_state.modal.retract+98);
+  #endif
+
   if (gc_state.modal.program_flow) {
     report_util_gcode_modes_M();
     switch (gc_state.modal.program_flow) {
@@ -470,11 +521,18 @@ void report_realtime_status()
   memcpy(current_position,sys_position,sizeof(sys_position));
   float print_position[N_AXIS];
   system_convert_array_steps_to_mpos(print_position,current_position);
+  #ifdef ENABLE_MESH_LEVELING
+    mesh_remove_offset(print_position); // Report the same positions the g-code parser works in.
+  #endif
 
   // Report current machine state and sub-states
   serial_write('<');
   switch (sys.state) {
-    case STATE_IDLE: printPgmString(PSTR("Idle")); break;
+    case STATE_IDLE:
+      #ifdef ENABLE_PROGRAM_MODE
+        if (sys.program_running) { printPgmString(PSTR("Run")); break; } // Waiting for program lines.
+      #endif
+      printPgmString(PSTR("Idle")); break;
     case STATE_CYCLE: printPgmString(PSTR("Run")); break;
     case STATE_HOLD:
       if (!(sys.suspend & SUSPEND_JOG_CANCEL)) {
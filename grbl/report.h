@@ -59,6 +59,9 @@
 #define STATUS_GCODE_UNUSED_WORDS 36
 #define STATUS_GCODE_G43_DYNAMIC_AXIS_ERROR 37
 #define STATUS_GCODE_MAX_VALUE_EXCEEDED 38
+#define STATUS_BINARY_CRC_ERROR 39
+#define STATUS_SUBPROGRAM_UNDEFINED 40
+#define STATUS_SUBPROGRAM_OVERFLOW 41
 
 // Define Grbl alarm codes. Valid values (1-255). 0 is reserved.
 #define ALARM_HARD_LIMIT_ERROR      EXEC_ALARM_HARD_LIMIT
@@ -114,6 +117,11 @@ void report_probe_parameters();
 // Prints Grbl NGC parameters (coordinate offsets, probe)
 void report_ngc_parameters();
 
+// Prints leveling mesh grid and Z offsets
+#ifdef ENABLE_MESH_LEVELING
+  void report_mesh();
+#endif
+
 // Prints current g-code parser mode state
 void report_gcode_modes();
 
@@ -21,13 +21,22 @@
 
 #include "grbl.h"
 
-#define RX_RING_BUFFER (RX_BUFFER_SIZE+1)
-#define TX_RING_BUFFER (TX_BUFFER_SIZE+1)
-
 uint8_t serial_rx_buffer[RX_RING_BUFFER];
 uint8_t serial_rx_buffer_head = 0;
 volatile uint8_t serial_rx_buffer_tail = 0;
 
+#ifdef RX_BUFFER_LINE_PARSING
+  // Line filtering flags of the receive interrupt. Same as the line flags in protocol.c.
+  #define RX_LINE_FLAG_OVERFLOW bit(0)
+  #define RX_LINE_FLAG_COMMENT_PARENTHESES bit(1)
+  #define RX_LINE_FLAG_COMMENT_SEMICOLON bit(2)
+
+  static uint8_t serial_rx_line_start = 0; // Index of the first character of the line being received.
+  static uint8_t serial_rx_line_flags = 0;
+  static volatile uint8_t serial_rx_lines_received = 0; // Complete lines counters. Compared
+  static uint8_t serial_rx_lines_released = 0;          // for available lines with 8-bit wrap.
+#endif
+
 uint8_t serial_tx_buffer[TX_RING_BUFFER];
 uint8_t serial_tx_buffer_head = 0;
 volatile uint8_t serial_tx_buffer_tail = 0;
@@ -119,10 +128,81 @@ uint8_t serial_read()
 }
 
 
+#ifdef RX_BUFFER_LINE_PARSING
+  uint8_t serial_get_line()
+  {
+    if (serial_rx_lines_received == serial_rx_lines_released) { return(SERIAL_NO_DATA); }
+    return(serial_rx_buffer_tail);
+  }
+
+
+  void serial_release_line()
+  {
+    uint8_t tail = serial_rx_buffer_tail;
+    while (serial_rx_buffer[tail] > SERIAL_LINE_OVERFLOW) { line_advance(tail); }
+    line_advance(tail); // Release the terminating zero or overflow marker.
+    serial_rx_buffer_tail = tail;
+    serial_rx_lines_released++;
+  }
+
+
+  // Stores a received character in the line being assembled in the RX buffer. Removes spaces,
+  // comments and block delete characters, and capitalizes letters, as protocol_main_loop() does
+  // for the line buffer. A line that does not fit in the buffer is replaced by an overflow marker.
+  static void serial_rx_line_put(uint8_t data)
+  {
+    uint8_t next_head;
+    if ((data == '\n') || (data == '\r')) { // End of line reached
+      if (serial_rx_line_flags & RX_LINE_FLAG_OVERFLOW) {
+        serial_rx_buffer_head = serial_rx_line_start; // Discard the stored part of the line.
+        data = SERIAL_LINE_OVERFLOW;
+      } else {
+        data = 0; // Zero-terminate the line.
+      }
+      next_head = serial_rx_buffer_head + 1;
+      if (next_head == RX_RING_BUFFER) { next_head = 0; }
+      if (next_head == serial_rx_buffer_tail) { return; } // Buffer full. Drop it as any other character.
+      serial_rx_buffer[serial_rx_buffer_head] = data;
+      serial_rx_buffer_head = next_head;
+      serial_rx_line_start = next_head;
+      serial_rx_line_flags = 0;
+      serial_rx_lines_received++;
+      return;
+    }
+
+    if (serial_rx_line_flags) {
+      // Throw away all (except EOL) comment characters and overflow characters.
+      if (data == ')') {
+        // End of '()' comment. Resume line allowed.
+        if (serial_rx_line_flags & RX_LINE_FLAG_COMMENT_PARENTHESES) { serial_rx_line_flags &= ~(RX_LINE_FLAG_COMMENT_PARENTHESES); }
+      }
+    } else if ((data <= ' ') || (data == '/')) {
+      // Throw away whitespace and control characters. Block delete NOT SUPPORTED.
+    } else if (data == '(') {
+      serial_rx_line_flags |= RX_LINE_FLAG_COMMENT_PARENTHESES;
+    } else if (data == ';') {
+      serial_rx_line_flags |= RX_LINE_FLAG_COMMENT_SEMICOLON;
+    } else {
+      if (data >= 'a' && data <= 'z') { data -= 'a'-'A'; } // Upcase lowercase
+      next_head = serial_rx_buffer_head + 1;
+      if (next_head == RX_RING_BUFFER) { next_head = 0; }
+      // Keep room to terminate the line, so a line longer than the buffer cannot fill it.
+      uint8_t next_next_head = next_head + 1;
+      if (next_next_head == RX_RING_BUFFER) { next_next_head = 0; }
+      if ((next_head == serial_rx_buffer_tail) || (next_next_head == serial_rx_buffer_tail)) {
+        serial_rx_line_flags |= RX_LINE_FLAG_OVERFLOW;
+      } else {
+        serial_rx_buffer[serial_rx_buffer_head] = data;
+        serial_rx_buffer_head = next_head;
+      }
+    }
+  }
+#endif
+
+
 ISR(SERIAL_RX_vect)
 {
   uint8_t data = SERIAL_IN;
-  uint8_t next_head;
 
   // Pick off realtime command characters directly from the serial stream. These characters are
   // not passed into the main buffer, but these set system state flag bits for realtime execution.
@@ -132,7 +212,12 @@ ISR(SERIAL_RX_vect)
     case CMD_CYCLE_START:   system_set_exec_state_flag(EXEC_CYCLE_START); break; // Set as true
     case CMD_FEED_HOLD:     system_set_exec_state_flag(EXEC_FEED_HOLD); break; // Set as true
     default :
-      if (data > 0x7F) { // Real-time control characters are extended ACSII only.
+      #ifdef ENABLE_BINARY_PROTOCOL
+        // The binary mode command is passed on in the stream, so input switches at its position.
+        if ((data > 0x7F) && (data != CMD_BINARY_MODE)) {
+      #else
+        if (data > 0x7F) { // Real-time control characters are extended ACSII only.
+      #endif
         switch(data) {
           case CMD_SAFETY_DOOR:   system_set_exec_state_flag(EXEC_SAFETY_DOOR); break; // Set as true
           case CMD_JOG_CANCEL:   
@@ -164,14 +249,18 @@ ISR(SERIAL_RX_vect)
         }
         // Throw away any unfound extended-ASCII character by not passing it to the serial buffer.
       } else { // Write character to buffer
-        next_head = serial_rx_buffer_head + 1;
-        if (next_head == RX_RING_BUFFER) { next_head = 0; }
-
-        // Write data to buffer unless it is full.
-        if (next_head != serial_rx_buffer_tail) {
-          serial_rx_buffer[serial_rx_buffer_head] = data;
-          serial_rx_buffer_head = next_head;
-        }
+        #ifdef RX_BUFFER_LINE_PARSING
+          serial_rx_line_put(data);
+        #else
+          uint8_t next_head = serial_rx_buffer_head + 1;
+          if (next_head == RX_RING_BUFFER) { next_head = 0; }
+
+          // Write data to buffer unless it is full.
+          if (next_head != serial_rx_buffer_tail) {
+            serial_rx_buffer[serial_rx_buffer_head] = data;
+            serial_rx_buffer_head = next_head;
+          }
+        #endif
       }
   }
 }
@@ -179,5 +268,15 @@ ISR(SERIAL_RX_vect)
 
 void serial_reset_read_buffer()
 {
-  serial_rx_buffer_tail = serial_rx_buffer_head;
+  #ifdef RX_BUFFER_LINE_PARSING
+    uint8_t sreg = SREG;
+    cli();
+    serial_rx_line_start = serial_rx_buffer_head; // Restart line assembly.
+    serial_rx_line_flags = 0;
+    serial_rx_lines_released = serial_rx_lines_received;
+    serial_rx_buffer_tail = serial_rx_buffer_head;
+    SREG = sreg;
+  #else
+    serial_rx_buffer_tail = serial_rx_buffer_head;
+  #endif
 }
@@ -34,8 +34,18 @@
   #endif
 #endif
 
+#define RX_RING_BUFFER (RX_BUFFER_SIZE+1)
+#define TX_RING_BUFFER (TX_BUFFER_SIZE+1)
+
 #define SERIAL_NO_DATA 0xff
 
+#ifdef RX_BUFFER_LINE_PARSING
+  // Stored in place of a line that did not fit in the RX buffer. Also terminates it.
+  #define SERIAL_LINE_OVERFLOW 0x01
+
+  extern uint8_t serial_rx_buffer[RX_RING_BUFFER];
+#endif
+
 
 void serial_init();
 
@@ -48,6 +58,16 @@ uint8_t serial_read();
 // Reset and empty data in read buffer. Used by e-stop and reset.
 void serial_reset_read_buffer();
 
+#ifdef RX_BUFFER_LINE_PARSING
+  // Returns the RX buffer index of the first character of the oldest complete line, or
+  // SERIAL_NO_DATA if no line is complete. The line is zero-terminated and wraps at the end
+  // of the buffer, so it must be read with line_advance().
+  uint8_t serial_get_line();
+
+  // Releases the RX buffer space of the oldest complete line, after it has been executed.
+  void serial_release_line();
+#endif
+
 // Returns the number of bytes available in the RX serial buffer.
 uint8_t serial_get_rx_buffer_available();
 
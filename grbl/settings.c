@@ -57,6 +57,19 @@ const __flash settings_t defaults = {\
     .acceleration[Z_AXIS] = DEFAULT_Z_ACCELERATION,
     .max_travel[X_AXIS] = (-DEFAULT_X_MAX_TRAVEL),
     .max_travel[Y_AXIS] = (-DEFAULT_Y_MAX_TRAVEL),
+    #ifdef HOMING_PARALLEL_AXES
+      .homing_axis_feed_rate[X_AXIS] = DEFAULT_X_HOMING_FEED_RATE,
+      .homing_axis_feed_rate[Y_AXIS] = DEFAULT_Y_HOMING_FEED_RATE,
+      .homing_axis_feed_rate[Z_AXIS] = DEFAULT_Z_HOMING_FEED_RATE,
+      .homing_axis_seek_rate[X_AXIS] = DEFAULT_X_HOMING_SEEK_RATE,
+      .homing_axis_seek_rate[Y_AXIS] = DEFAULT_Y_HOMING_SEEK_RATE,
+      .homing_axis_seek_rate[Z_AXIS] = DEFAULT_Z_HOMING_SEEK_RATE,
+    #endif
+    #ifdef ENABLE_BACKLASH_COMPENSATION
+      .backlash[X_AXIS] = DEFAULT_X_BACKLASH,
+      .backlash[Y_AXIS] = DEFAULT_Y_BACKLASH,
+      .backlash[Z_AXIS] = DEFAULT_Z_BACKLASH,
+    #endif
     .max_travel[Z_AXIS] = (-DEFAULT_Z_MAX_TRAVEL)};
 
 
@@ -123,6 +136,9 @@ void settings_restore(uint8_t restore_flag) {
       eeprom_put_char(EEPROM_ADDR_STARTUP_BLOCK+(LINE_BUFFER_SIZE+1), 0);
       eeprom_put_char(EEPROM_ADDR_STARTUP_BLOCK+(LINE_BUFFER_SIZE+2), 0); // Checksum
     #endif
+    #ifdef ENABLE_SUBPROGRAMS
+      subprogram_clear();
+    #endif
   }
 
   if (restore_flag & SETTINGS_RESTORE_BUILD_INFO) {
@@ -215,6 +231,18 @@ uint8_t settings_store_global_setting(uint8_t parameter, float value) {
             break;
           case 2: settings.acceleration[parameter] = value*60*60; break; // Convert to mm/min^2 for grbl internal use.
           case 3: settings.max_travel[parameter] = -value; break;  // Store as negative for grbl internal use.
+          #ifdef HOMING_PARALLEL_AXES
+            case 4: settings.homing_axis_feed_rate[parameter] = value; break;
+            case 5: settings.homing_axis_seek_rate[parameter] = value; break;
+          #elif defined(ENABLE_BACKLASH_COMPENSATION)
+            case 4: case 5: return(STATUS_INVALID_STATEMENT);
+          #endif
+          #ifdef ENABLE_BACKLASH_COMPENSATION
+            case 6:
+              if (value < 0.0) { return(STATUS_NEGATIVE_VALUE); }
+              settings.backlash[parameter] = value;
+              break;
+          #endif
         }
         break; // Exit while-loop after setting has been configured and proceed to the EEPROM write call.
       } else {
@@ -66,6 +66,9 @@
 // the startup script. The lower half contains the global settings and space for future
 // developments.
 #define EEPROM_ADDR_GLOBAL         1U
+#define EEPROM_ADDR_MESH           256U // Leveling mesh. Up to 255 bytes, including checksum.
+#define EEPROM_ADDR_SUBPROGRAMS    256U // O-word subprograms. Shares the mesh space.
+#define EEPROM_ADDR_SUBPROGRAMS_END 511U
 #define EEPROM_ADDR_PARAMETERS     512U
 #define EEPROM_ADDR_STARTUP_BLOCK  768U
 #define EEPROM_ADDR_BUILD_INFO     942U
@@ -79,7 +82,13 @@
 // #define SETTING_INDEX_G92    N_COORDINATE_SYSTEM+2  // Coordinate offset (G92.2,G92.3 not supported)
 
 // Define Grbl axis settings numbering scheme. Starts at START_VAL, every INCREMENT, over N_SETTINGS.
-#define AXIS_N_SETTINGS          4
+#if defined(ENABLE_BACKLASH_COMPENSATION)
+  #define AXIS_N_SETTINGS        7 // Adds per-axis backlash ($16x). $14x and $15x require HOMING_PARALLEL_AXES.
+#elif defined(HOMING_PARALLEL_AXES)
+  #define AXIS_N_SETTINGS        6 // Adds per-axis homing feed ($14x) and seek ($15x) rates.
+#else
+  #define AXIS_N_SETTINGS        4
+#endif
 #define AXIS_SETTINGS_START_VAL  100 // NOTE: Reserving settings values >= 100 for axis settings. Up to 255.
 #define AXIS_SETTINGS_INCREMENT  10  // Must be greater than the number of axis settings
 
@@ -110,6 +119,14 @@ typedef struct {
   float homing_seek_rate;
   uint16_t homing_debounce_delay;
   float homing_pulloff;
+
+  #ifdef HOMING_PARALLEL_AXES
+    float homing_axis_feed_rate[N_AXIS];
+    float homing_axis_seek_rate[N_AXIS];
+  #endif
+  #ifdef ENABLE_BACKLASH_COMPENSATION
+    float backlash[N_AXIS];
+  #endif
 } settings_t;
 extern settings_t settings;
 
@@ -270,20 +270,57 @@ void spindle_stop()
 }
 
 
+#ifdef PLANNED_ACCESSORY_STATE
+  // Sets the spindle direction and enable outputs of a planned block state. The segment PWM value
+  // then sets the speed. Called by the stepper ISR when a block changes the state. Keep routine small.
+  void spindle_set_planned_state(uint8_t state)
+  {
+    if (state == SPINDLE_DISABLE) {
+      spindle_stop();
+    } else {
+      #if !defined(USE_SPINDLE_DIR_AS_ENABLE_PIN) && !defined(ENABLE_DUAL_AXIS)
+        if (state == SPINDLE_ENABLE_CW) {
+          GPIO_SET_PIN(SPINDLE_DIRECTION, false);
+        } else {
+          GPIO_SET_PIN(SPINDLE_DIRECTION, true);
+        }
+      #endif
+      #if (defined(USE_SPINDLE_DIR_AS_ENABLE_PIN) && \
+          !defined(SPINDLE_ENABLE_OFF_WITH_ZERO_SPEED)) || !defined(VARIABLE_SPINDLE)
+        #ifdef INVERT_SPINDLE_ENABLE_PIN
+          GPIO_SET_PIN(SPINDLE_ENABLE, false);
+        #else
+          GPIO_SET_PIN(SPINDLE_ENABLE, true);
+        #endif
+      #endif
+    }
+    sys.report_ovr_counter = 0; // Set to report change immediately
+  }
+#endif
+
+
 // G-code parser entry-point for setting spindle state. Forces a planner buffer sync and bails 
 // if an abort or check-mode is active.
 #ifdef VARIABLE_SPINDLE
   void spindle_sync(uint8_t state, float rpm)
   {
     if (sys.state == STATE_CHECK_MODE) { return; }
-    protocol_buffer_synchronize(); // Empty planner buffer to ensure spindle is set when programmed.
+    #ifdef PLANNED_ACCESSORY_STATE
+      if (!protocol_accessory_sync()) { return; } // Set by the stepper with the next block.
+    #else
+      protocol_buffer_synchronize(); // Empty planner buffer to ensure spindle is set when programmed.
+    #endif
     spindle_set_state(state,rpm);
   }
 #else
   void _spindle_sync(uint8_t state)
   {
     if (sys.state == STATE_CHECK_MODE) { return; }
-    protocol_buffer_synchronize(); // Empty planner buffer to ensure spindle is set when programmed.
+    #ifdef PLANNED_ACCESSORY_STATE
+      if (!protocol_accessory_sync()) { return; } // Set by the stepper with the next block.
+    #else
+      protocol_buffer_synchronize(); // Empty planner buffer to ensure spindle is set when programmed.
+    #endif
     _spindle_set_state(state);
   }
 #endif
@@ -69,5 +69,10 @@ uint8_t spindle_get_state();
 // Stop and start spindle routines. Called by all spindle routines and stepper ISR.
 void spindle_stop();
 
+#ifdef PLANNED_ACCESSORY_STATE
+  // Sets spindle direction and enable outputs at the start of a planner block. Called by stepper ISR.
+  void spindle_set_planned_state(uint8_t state);
+#endif
+
 
 #endif
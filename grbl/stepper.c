@@ -44,18 +44,61 @@
 // NOTE: AMASS cutoff frequency multiplied by ISR overdrive factor must not exceed maximum step frequency.
 // NOTE: Current settings are set to overdrive the ISR to no more than 16kHz, balancing CPU overhead
 // and timer accuracy.  Do not alter these settings unless you know what you are doing.
+// NOTE: A 32-bit step timer times slow segments directly, so it also supports two more levels for
+// the step frequencies below 1kHz, where the 16-bit timer would otherwise have to clamp.
 #ifdef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
-	#define MAX_AMASS_LEVEL 3
+  #if SPT_PERIOD_BITS > 16
+    #define MAX_AMASS_LEVEL 5
+  #else
+    #define MAX_AMASS_LEVEL 3
+  #endif
 	// AMASS_LEVEL0: Normal operation. No AMASS. No upper cutoff frequency. Starts at LEVEL1 cutoff frequency.
 	#define AMASS_LEVEL1 (F_CPU/8000) // Over-drives ISR (x2). Defined as F_CPU/(Cutoff frequency in Hz)
 	#define AMASS_LEVEL2 (F_CPU/4000) // Over-drives ISR (x4)
 	#define AMASS_LEVEL3 (F_CPU/2000) // Over-drives ISR (x8)
+	#define AMASS_LEVEL4 (F_CPU/1000) // Over-drives ISR (x16). 32-bit step timer only.
+	#define AMASS_LEVEL5 (F_CPU/500)  // Over-drives ISR (x32). 32-bit step timer only.
 
   #if MAX_AMASS_LEVEL <= 0
     error "AMASS must have 1 or more levels to operate correctly."
   #endif
 #endif
 
+// Fixed-point segment generator scaling. Step distances are carried in unsigned Q24.8 format and
+// segment times in timer cycles, so the per-segment rate computation needs no float division.
+#ifdef FIXED_POINT_SEGMENT_GENERATOR
+  #define STEP_FRAC_BITS 8
+  #define STEP_FRAC_ONE (1UL<<STEP_FRAC_BITS)
+  #define CYCLES_PER_MINUTE (TICKS_PER_MICROSECOND*1000000*60.0)
+  #define st_sqrt(x) st_fixed_sqrt(x)
+#else
+  #define st_sqrt(x) sqrt(x)
+#endif
+
+
+// Step timer period type, as wide as the port step timer.
+#if SPT_PERIOD_BITS > 16
+  typedef uint32_t spt_period_t;
+#else
+  typedef uint16_t spt_period_t;
+#endif
+
+#ifdef STEP_BURST_MODE
+  #define STEP_BURST_CYCLES (F_CPU/STEP_BURST_CUTOFF_HZ) // Step period below which steps are burst.
+#endif
+
+#ifdef DDA_STEP_ENGINE
+  #define DDA_TICK_CYCLES (F_CPU/DDA_TICK_FREQUENCY) // Fixed stepper ISR period in timer cycles.
+#endif
+
+// Dwell blocks are executed as idle segments of 100usec ticks. The tick is below the AMASS level 1 and
+// above the burst cutoff periods, so it needs no prescaler or step rate adjustments.
+#ifdef PLAN_DWELL_BLOCKS
+  #define DWELL_TICK_CYCLES (F_CPU/10000)
+  #define DWELL_TICKS_PER_MS 10
+  #define DWELL_MS_PER_SEGMENT (1000/ACCELERATION_TICKS_PER_SECOND)
+#endif
+
 
 // Stores the planner block Bresenham algorithm execution data for the segments in the segment
 // buffer. Normally, this buffer is partially in-use, but, for the worst case scenario, it will
@@ -73,6 +116,13 @@ typedef struct {
   #ifdef VARIABLE_SPINDLE
     uint8_t is_pwm_rate_adjusted; // Tracks motions that require constant laser power/rate
   #endif
+  #ifdef ENABLE_BACKLASH_COMPENSATION
+    int8_t position_step[N_AXIS]; // Machine position change per step. Zero in compensation blocks.
+  #endif
+  #ifdef PLANNED_ACCESSORY_STATE
+    uint8_t accessory_state;  // Spindle and coolant condition flags set at the start of the block
+    uint8_t accessory_update; // Set when the state differs from the previous block
+  #endif
 } st_block_t;
 static st_block_t st_block_buffer[SEGMENT_BUFFER_SIZE-1];
 
@@ -82,13 +132,20 @@ static st_block_t st_block_buffer[SEGMENT_BUFFER_SIZE-1];
 // the planner, where the remaining planner block steps still can.
 typedef struct {
   uint16_t n_step;           // Number of step events to be executed for this segment
-  uint16_t cycles_per_tick;  // Step distance traveled per ISR tick, aka step rate.
+  spt_period_t cycles_per_tick;  // Step distance traveled per ISR tick, aka step rate.
   uint8_t  st_block_index;   // Stepper block data index. Uses this information to execute this segment.
   #ifdef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
     uint8_t amass_level;    // Indicates AMASS level for the ISR to execute this segment
-  #else
+  #elif SPT_PERIOD_BITS <= 16
     uint8_t prescaler;      // Without AMASS, a prescaler is required to adjust for slow timing.
   #endif
+  #ifdef STEP_BURST_MODE
+    uint8_t burst_level;    // Executes 2^burst_level steps per ISR tick
+  #endif
+  #ifdef DDA_STEP_ENGINE
+    uint16_t dda_quota[N_AXIS]; // Steps of each axis left to execute in this segment. n_step counts ticks.
+    uint32_t dda_inc[N_AXIS];   // Phase accumulator increment of each axis per ISR tick
+  #endif
   #ifdef VARIABLE_SPINDLE
     uint8_t spindle_pwm;
   #endif
@@ -116,6 +173,12 @@ typedef struct {
   #ifdef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
     uint32_t steps[N_AXIS];
   #endif
+  #ifdef STEP_BURST_MODE
+    uint8_t burst_level;       // Burst level of the executing segment
+  #endif
+  #ifdef DDA_STEP_ENGINE
+    uint32_t dda_phase[N_AXIS]; // Phase accumulators. An axis steps when its phase overflows.
+  #endif
 
   uint16_t step_count;       // Steps remaining in line segment motion
   uint8_t exec_block_index; // Tracks the current st_block index. Change indicates new block.
@@ -140,6 +203,15 @@ static uint8_t dir_port_invert_mask;
 // Used to avoid ISR nesting of the "Stepper Driver Interrupt". Should never occur though.
 static volatile uint8_t busy;
 
+#ifdef HOMING_LATCH_TRIGGER_POSITION
+  // Set when the limit pin change interrupt fired during the position update of the stepper ISR.
+  static volatile uint8_t homing_latch_deferred;
+#endif
+
+// Milliseconds remaining of the stepper idle lock. While non-zero, the Stepper Driver Interrupt
+// runs as a millisecond timer and disables the steppers when the count expires.
+static volatile uint8_t idle_lock_count;
+
 // Pointers for the step segment being prepped from the planner buffer. Accessed only by the
 // main program. Pointers may be planning segments or planner blocks ahead of what being executed.
 static plan_block_t *pl_block;     // Pointer to the planner block being prepped
@@ -151,16 +223,46 @@ typedef struct {
   uint8_t st_block_index;  // Index of stepper common data block being prepped
   uint8_t recalculate_flag;
 
-  float dt_remainder;
-  float steps_remaining;
-  float step_per_mm;
+  #ifdef FIXED_POINT_SEGMENT_GENERATOR
+    uint32_t dt_remainder;   // Partial step execute time (timer cycles)
+    uint32_t steps_remaining; // Whole steps remaining in block
+  #else
+    float dt_remainder;
+    float steps_remaining;
+  #endif
+  float step_per_mm;       // NOTE: Scaled by STEP_FRAC_ONE with the fixed-point segment generator.
   float req_mm_increment;
 
   #ifdef PARKING_ENABLE
     uint8_t last_st_block_index;
-    float last_steps_remaining;
+    #ifdef FIXED_POINT_SEGMENT_GENERATOR
+      uint32_t last_steps_remaining;
+      uint32_t last_dt_remainder;
+    #else
+      float last_steps_remaining;
+      float last_dt_remainder;
+    #endif
     float last_step_per_mm;
-    float last_dt_remainder;
+    #ifdef DDA_STEP_ENGINE
+      uint32_t last_dda_steps_done[N_AXIS];
+    #endif
+  #endif
+
+  #ifdef NATIVE_ARC_BLOCKS
+    float arc_inv_length;       // Inverse of the arc block length (1/mm)
+    float arc_start[2];         // Radius vector of the arc start point (mm)
+    float arc_segment_mm;       // Maximum segment travel with a chord inside the arc tolerance (mm)
+    int32_t arc_steps[N_AXIS];  // Last prepped arc point relative to the arc start point (steps)
+  #endif
+
+  #ifdef DDA_STEP_ENGINE
+    uint32_t dda_steps_done[N_AXIS];  // Steps of each axis checked-out of the block so far
+    float dda_step_ratio[N_AXIS];     // Axis steps per step event of the block
+    uint32_t dda_cycle_remainder;     // Segment time not yet issued as whole DDA ticks (timer cycles)
+  #endif
+
+  #ifdef STEP_BURST_MODE
+    uint16_t burst_cycle_remainder;   // Segment time not yet issued as whole burst ticks (timer cycles)
   #endif
 
   uint8_t ramp_type;      // Current segment ramp state
@@ -176,6 +278,9 @@ typedef struct {
     float inv_rate;    // Used by PWM laser mode to speed up segment calculations.
     uint8_t current_spindle_pwm; 
   #endif
+  #ifdef PLANNED_ACCESSORY_STATE
+    uint8_t accessory_state; // Spindle and coolant state of the last prepped g-code block
+  #endif
 } st_prep_t;
 static st_prep_t prep;
 
@@ -223,6 +328,9 @@ static st_prep_t prep;
 // enabled. Startup init and limits call this function but shouldn't start the cycle.
 void st_wake_up()
 {
+  // Cancel any pending stepper idle lock, so the drivers are not disabled under the new motion.
+  idle_lock_count = 0;
+
   // Enable stepper drivers.
   GPIO_SET_PIN(STEPPERS_DISABLE, bit_istrue(settings.flags,BITFLAG_INVERT_ST_ENABLE));
 
@@ -245,26 +353,220 @@ void st_wake_up()
 }
 
 
-// Stepper shutdown
+// Disables the stepper drivers, applying the enable pin invert setting.
+static void st_disable_steppers()
+{
+  GPIO_SET_PIN(STEPPERS_DISABLE, bit_isfalse(settings.flags,BITFLAG_INVERT_ST_ENABLE));
+}
+
+
+// Stepper shutdown. Called from the Stepper Driver Interrupt at cycle end, so this must not block.
 void st_go_idle()
 {
   // Disable Stepper Driver Interrupt. Allow Stepper Port Reset Interrupt to finish, if active.
   SPT_STOP;
   busy = false;
+  idle_lock_count = 0;
 
   // Set stepper driver idle state, disabled or enabled, depending on settings and circumstances.
-  bool pin_state = false; // Keep enabled.
   if (((settings.stepper_idle_lock_time != 0xff) || sys_rt_exec_alarm || sys.state == STATE_SLEEP) && sys.state != STATE_HOMING) {
-    // Force stepper dwell to lock axes for a defined amount of time to ensure the axes come to a complete
-    // stop and not drift from residual inertial forces at the end of the last movement.
-    delay_ms(settings.stepper_idle_lock_time);
-    pin_state = true; // Override. Disable steppers.
+    // Lock axes for a defined amount of time to ensure the axes come to a complete stop and not
+    // drift from residual inertial forces at the end of the last movement. Rather than delaying
+    // here, the Stepper Driver Interrupt counts down the lock time in 1 msec ticks and disables the
+    // steppers when done. st_wake_up() cancels the countdown, if motion resumes before then.
+    if (settings.stepper_idle_lock_time) {
+      idle_lock_count = settings.stepper_idle_lock_time;
+      SPT_SET(TICKS_PER_MICROSECOND*1000UL); // 1 msec period. Fits the 16-bit timer without a prescaler.
+      SPT_START;
+    } else {
+      st_disable_steppers();
+    }
+  } else {
+    // Keep enabled.
+    GPIO_SET_PIN(STEPPERS_DISABLE, bit_istrue(settings.flags,BITFLAG_INVERT_ST_ENABLE));
   }
-  if (bit_istrue(settings.flags,BITFLAG_INVERT_ST_ENABLE)) { pin_state = !pin_state; } // Apply pin invert.
-  GPIO_SET_PIN(STEPPERS_DISABLE, pin_state);
 }
 
 
+// Executes one step event of the current segment by the Bresenham line algorithm and stores the
+// resulting step bits to be output at the next step pulse. Called by the Stepper Driver Interrupt.
+static inline void st_bresenham_step()
+{
+  // Check probing state.
+  if (sys_probe_state == PROBE_ACTIVE) { probe_state_monitor(); }
+
+  // Reset step out bits.
+  st.step_outbits = 0;
+  #ifdef ENABLE_DUAL_AXIS
+    st.step_outbits_dual = 0;
+  #endif
+
+  // Execute step displacement profile by Bresenham line algorithm
+  #ifdef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
+    st.counter_x += st.steps[X_AXIS];
+  #else
+    st.counter_x += st.exec_block->steps[X_AXIS];
+  #endif
+  if (st.counter_x > st.exec_block->step_event_count) {
+    st.step_outbits |= (1<<X_STEP_BIT);
+    #if defined(ENABLE_DUAL_AXIS) && (DUAL_AXIS_SELECT == X_AXIS)
+      st.step_outbits_dual = (1<<STEP_DUAL_BIT);
+    #endif
+    st.counter_x -= st.exec_block->step_event_count;
+    #ifdef ENABLE_BACKLASH_COMPENSATION
+      sys_position[X_AXIS] += st.exec_block->position_step[X_AXIS];
+    #else
+      if (st.exec_block->direction_bits & (1<<X_DIRECTION_BIT)) { sys_position[X_AXIS]--; }
+      else { sys_position[X_AXIS]++; }
+    #endif
+  }
+  #ifdef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
+    st.counter_y += st.steps[Y_AXIS];
+  #else
+    st.counter_y += st.exec_block->steps[Y_AXIS];
+  #endif
+  if (st.counter_y > st.exec_block->step_event_count) {
+    st.step_outbits |= (1<<Y_STEP_BIT);
+    #if defined(ENABLE_DUAL_AXIS) && (DUAL_AXIS_SELECT == Y_AXIS)
+      st.step_outbits_dual = (1<<STEP_DUAL_BIT);
+    #endif
+    st.counter_y -= st.exec_block->step_event_count;
+    #ifdef ENABLE_BACKLASH_COMPENSATION
+      sys_position[Y_AXIS] += st.exec_block->position_step[Y_AXIS];
+    #else
+      if (st.exec_block->direction_bits & (1<<Y_DIRECTION_BIT)) { sys_position[Y_AXIS]--; }
+      else { sys_position[Y_AXIS]++; }
+    #endif
+  }
+  #ifdef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
+    st.counter_z += st.steps[Z_AXIS];
+  #else
+    st.counter_z += st.exec_block->steps[Z_AXIS];
+  #endif
+  if (st.counter_z > st.exec_block->step_event_count) {
+    st.step_outbits |= (1<<Z_STEP_BIT);
+    st.counter_z -= st.exec_block->step_event_count;
+    #ifdef ENABLE_BACKLASH_COMPENSATION
+      sys_position[Z_AXIS] += st.exec_block->position_step[Z_AXIS];
+    #else
+      if (st.exec_block->direction_bits & (1<<Z_DIRECTION_BIT)) { sys_position[Z_AXIS]--; }
+      else { sys_position[Z_AXIS]++; }
+    #endif
+  }
+
+  // During a homing cycle, lock out and prevent desired axes from moving.
+  if (sys.state == STATE_HOMING) { 
+    st.step_outbits &= sys.homing_axis_lock;
+    #ifdef ENABLE_DUAL_AXIS
+      st.step_outbits_dual &= sys.homing_axis_lock_dual;
+    #endif
+  }
+
+  st.step_count--; // Decrement step events count
+  if (st.step_count == 0) {
+    // Segment is complete. Discard current segment and advance segment indexing.
+    st.exec_segment = NULL;
+    if ( ++segment_buffer_tail == SEGMENT_BUFFER_SIZE) { segment_buffer_tail = 0; }
+  }
+
+  st.step_outbits ^= step_port_invert_mask;  // Apply step port invert mask
+  #ifdef ENABLE_DUAL_AXIS
+    st.step_outbits_dual ^= step_port_invert_mask_dual;
+  #endif
+}
+
+
+#ifdef DDA_STEP_ENGINE
+  // Executes one fixed-frequency tick of the current segment by the DDA phase accumulators and
+  // stores the resulting step bits to be output at the next step pulse. An axis steps when its
+  // phase overflows, until its segment step quota is met. On the last tick of the segment, any
+  // step still owed from phase round-off is forced, so segment step counts are always exact.
+  static inline void st_dda_step()
+  {
+    // Check probing state.
+    if (sys_probe_state == PROBE_ACTIVE) { probe_state_monitor(); }
+
+    // Reset step out bits.
+    st.step_outbits = 0;
+    #ifdef ENABLE_DUAL_AXIS
+      st.step_outbits_dual = 0;
+    #endif
+
+    segment_t *segment = st.exec_segment;
+    uint8_t last_tick = (st.step_count == 1);
+    uint32_t phase;
+    if (segment->dda_quota[X_AXIS]) {
+      phase = st.dda_phase[X_AXIS] + segment->dda_inc[X_AXIS];
+      if ((phase < st.dda_phase[X_AXIS]) || last_tick) {
+        st.step_outbits |= (1<<X_STEP_BIT);
+        #if defined(ENABLE_DUAL_AXIS) && (DUAL_AXIS_SELECT == X_AXIS)
+          st.step_outbits_dual = (1<<STEP_DUAL_BIT);
+        #endif
+        segment->dda_quota[X_AXIS]--;
+        #ifdef ENABLE_BACKLASH_COMPENSATION
+          sys_position[X_AXIS] += st.exec_block->position_step[X_AXIS];
+        #else
+          if (st.exec_block->direction_bits & (1<<X_DIRECTION_BIT)) { sys_position[X_AXIS]--; }
+          else { sys_position[X_AXIS]++; }
+        #endif
+      }
+      st.dda_phase[X_AXIS] = phase;
+    }
+    if (segment->dda_quota[Y_AXIS]) {
+      phase = st.dda_phase[Y_AXIS] + segment->dda_inc[Y_AXIS];
+      if ((phase < st.dda_phase[Y_AXIS]) || last_tick) {
+        st.step_outbits |= (1<<Y_STEP_BIT);
+        #if defined(ENABLE_DUAL_AXIS) && (DUAL_AXIS_SELECT == Y_AXIS)
+          st.step_outbits_dual = (1<<STEP_DUAL_BIT);
+        #endif
+        segment->dda_quota[Y_AXIS]--;
+        #ifdef ENABLE_BACKLASH_COMPENSATION
+          sys_position[Y_AXIS] += st.exec_block->position_step[Y_AXIS];
+        #else
+          if (st.exec_block->direction_bits & (1<<Y_DIRECTION_BIT)) { sys_position[Y_AXIS]--; }
+          else { sys_position[Y_AXIS]++; }
+        #endif
+      }
+      st.dda_phase[Y_AXIS] = phase;
+    }
+    if (segment->dda_quota[Z_AXIS]) {
+      phase = st.dda_phase[Z_AXIS] + segment->dda_inc[Z_AXIS];
+      if ((phase < st.dda_phase[Z_AXIS]) || last_tick) {
+        st.step_outbits |= (1<<Z_STEP_BIT);
+        segment->dda_quota[Z_AXIS]--;
+        #ifdef ENABLE_BACKLASH_COMPENSATION
+          sys_position[Z_AXIS] += st.exec_block->position_step[Z_AXIS];
+        #else
+          if (st.exec_block->direction_bits & (1<<Z_DIRECTION_BIT)) { sys_position[Z_AXIS]--; }
+          else { sys_position[Z_AXIS]++; }
+        #endif
+      }
+      st.dda_phase[Z_AXIS] = phase;
+    }
+
+    // During a homing cycle, lock out and prevent desired axes from moving.
+    if (sys.state == STATE_HOMING) {
+      st.step_outbits &= sys.homing_axis_lock;
+      #ifdef ENABLE_DUAL_AXIS
+        st.step_outbits_dual &= sys.homing_axis_lock_dual;
+      #endif
+    }
+
+    st.step_count--; // Decrement segment ticks count
+    if (st.step_count == 0) {
+      // Segment is complete. Discard current segment and advance segment indexing.
+      st.exec_segment = NULL;
+      if ( ++segment_buffer_tail == SEGMENT_BUFFER_SIZE) { segment_buffer_tail = 0; }
+    }
+
+    st.step_outbits ^= step_port_invert_mask;  // Apply step port invert mask
+    #ifdef ENABLE_DUAL_AXIS
+      st.step_outbits_dual ^= step_port_invert_mask_dual;
+    #endif
+  }
+#endif
+
+
 /* "The Stepper Driver Interrupt" - This timer interrupt is the workhorse of Grbl. Grbl employs
    the venerable Bresenham line algorithm to manage and exactly synchronize multi-axis moves.
    Unlike the popular DDA algorithm, the Bresenham algorithm is not susceptible to numerical
@@ -317,6 +619,15 @@ ISR(TIMER1_COMPA_vect)
 {
   if (busy) { return; } // The busy-flag is used to avoid reentering this interrupt
 
+  // Stepper idle lock countdown set up by st_go_idle(). No motion is executing.
+  if (idle_lock_count) {
+    if (--idle_lock_count == 0) {
+      SPT_STOP;
+      st_disable_steppers();
+    }
+    return;
+  }
+
   // Set the direction pins a couple of nanoseconds before we step the steppers
   GPIO_SET_PINS(DIRECTION, st.dir_outbits);
 
@@ -353,22 +664,38 @@ ISR(TIMER1_COMPA_vect)
       // Initialize new step segment and load number of steps to execute
       st.exec_segment = &segment_buffer[segment_buffer_tail];
 
-      #ifndef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
+      #if !defined(ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING) && (SPT_PERIOD_BITS <= 16)
         // With AMASS is disabled, set timer prescaler for segments with slow step frequencies (< 250Hz).
-        TCCR1B = (TCCR1B & ~(0x07<<CS10)) | (st.exec_segment->prescaler<<CS10);
+        SPT_PRESCALER(st.exec_segment->prescaler);
       #endif
 
       // Initialize step segment timing per step and load number of steps to execute.
       SPT_SET (st.exec_segment->cycles_per_tick);
       st.step_count = st.exec_segment->n_step; // NOTE: Can sometimes be zero when moving slow.
+      #ifdef STEP_BURST_MODE
+        st.burst_level = st.exec_segment->burst_level;
+      #endif
       // If the new segment starts a new planner block, initialize stepper variables and counters.
       // NOTE: When the segment data index changes, this indicates a new planner block.
       if ( st.exec_block_index != st.exec_segment->st_block_index ) {
         st.exec_block_index = st.exec_segment->st_block_index;
         st.exec_block = &st_block_buffer[st.exec_block_index];
 
-        // Initialize Bresenham line and distance counters
-        st.counter_x = st.counter_y = st.counter_z = (st.exec_block->step_event_count >> 1);
+        #ifdef DDA_STEP_ENGINE
+          // Initialize DDA phase accumulators at half a step, like the Bresenham counters.
+          st.dda_phase[X_AXIS] = st.dda_phase[Y_AXIS] = st.dda_phase[Z_AXIS] = 0x80000000;
+        #else
+          // Initialize Bresenham line and distance counters
+          st.counter_x = st.counter_y = st.counter_z = (st.exec_block->step_event_count >> 1);
+        #endif
+
+        #ifdef PLANNED_ACCESSORY_STATE
+          // Set programmed spindle and coolant changes as the block starts. PWM follows with the segment.
+          if (st.exec_block->accessory_update) {
+            spindle_set_planned_state(st.exec_block->accessory_state & PL_COND_SPINDLE_MASK);
+            coolant_set_state(st.exec_block->accessory_state);
+          }
+        #endif
       }
       st.dir_outbits = st.exec_block->direction_bits ^ dir_port_invert_mask;
       #ifdef ENABLE_DUAL_AXIS
@@ -400,79 +727,58 @@ ISR(TIMER1_COMPA_vect)
   }
 
 
-  // Check probing state.
-  if (sys_probe_state == PROBE_ACTIVE) { probe_state_monitor(); }
-
-  // Reset step out bits.
-  st.step_outbits = 0;
-  #ifdef ENABLE_DUAL_AXIS
-    st.step_outbits_dual = 0;
-  #endif
-
-  // Execute step displacement profile by Bresenham line algorithm
-  #ifdef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
-    st.counter_x += st.steps[X_AXIS];
-  #else
-    st.counter_x += st.exec_block->steps[X_AXIS];
-  #endif
-  if (st.counter_x > st.exec_block->step_event_count) {
-    st.step_outbits |= (1<<X_STEP_BIT);
-    #if defined(ENABLE_DUAL_AXIS) && (DUAL_AXIS_SELECT == X_AXIS)
-      st.step_outbits_dual = (1<<STEP_DUAL_BIT);
-    #endif
-    st.counter_x -= st.exec_block->step_event_count;
-    if (st.exec_block->direction_bits & (1<<X_DIRECTION_BIT)) { sys_position[X_AXIS]--; }
-    else { sys_position[X_AXIS]++; }
-  }
-  #ifdef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
-    st.counter_y += st.steps[Y_AXIS];
-  #else
-    st.counter_y += st.exec_block->steps[Y_AXIS];
-  #endif
-  if (st.counter_y > st.exec_block->step_event_count) {
-    st.step_outbits |= (1<<Y_STEP_BIT);
-    #if defined(ENABLE_DUAL_AXIS) && (DUAL_AXIS_SELECT == Y_AXIS)
-      st.step_outbits_dual = (1<<STEP_DUAL_BIT);
-    #endif
-    st.counter_y -= st.exec_block->step_event_count;
-    if (st.exec_block->direction_bits & (1<<Y_DIRECTION_BIT)) { sys_position[Y_AXIS]--; }
-    else { sys_position[Y_AXIS]++; }
-  }
-  #ifdef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
-    st.counter_z += st.steps[Z_AXIS];
+  #ifdef DDA_STEP_ENGINE
+    st_dda_step();
   #else
-    st.counter_z += st.exec_block->steps[Z_AXIS];
+    st_bresenham_step();
   #endif
-  if (st.counter_z > st.exec_block->step_event_count) {
-    st.step_outbits |= (1<<Z_STEP_BIT);
-    st.counter_z -= st.exec_block->step_event_count;
-    if (st.exec_block->direction_bits & (1<<Z_DIRECTION_BIT)) { sys_position[Z_AXIS]--; }
-    else { sys_position[Z_AXIS]++; }
-  }
 
-  // During a homing cycle, lock out and prevent desired axes from moving.
-  if (sys.state == STATE_HOMING) { 
-    st.step_outbits &= sys.homing_axis_lock;
-    #ifdef ENABLE_DUAL_AXIS
-      st.step_outbits_dual &= sys.homing_axis_lock_dual;
-    #endif
-  }
-
-  st.step_count--; // Decrement step events count
-  if (st.step_count == 0) {
-    // Segment is complete. Discard current segment and advance segment indexing.
-    st.exec_segment = NULL;
-    if ( ++segment_buffer_tail == SEGMENT_BUFFER_SIZE) { segment_buffer_tail = 0; }
-  }
+  #ifdef STEP_BURST_MODE
+    // Emit the remaining steps of a burst as a tight pulse train right after the first, spaced by the
+    // $0 pulse time high and low, and leave the rest of the tick free. The tick's first pulse is reset
+    // by The Stepper Port Reset Interrupt within one pulse time. The train times and resets its own
+    // pulses. A completed segment ends the burst, since the next segment loads next tick.
+    if (st.burst_level) {
+      uint8_t burst_count = (1<<st.burst_level)-1;
+      delay_us(settings.pulse_microseconds); // First pulse ends.
+      while (burst_count-- && (st.exec_segment != NULL)) {
+        delay_us(settings.pulse_microseconds); // Step low time
+        GPIO_SET_PINS(STEP, st.step_outbits);
+        #ifdef ENABLE_DUAL_AXIS
+          GPIO_SET_PINS(STEP_DUAL, st.step_outbits_dual);
+        #endif
+        delay_us(settings.pulse_microseconds); // Step pulse time
+        GPIO_SET_PINS(STEP, step_port_invert_mask);
+        #ifdef ENABLE_DUAL_AXIS
+          GPIO_SET_PINS(STEP_DUAL, step_port_invert_mask_dual);
+        #endif
+        st_bresenham_step();
+      }
+    }
+  #endif
 
-  st.step_outbits ^= step_port_invert_mask;  // Apply step port invert mask
-  #ifdef ENABLE_DUAL_AXIS
-    st.step_outbits_dual ^= step_port_invert_mask_dual;
+  #ifdef HOMING_LATCH_TRIGGER_POSITION
+    if (homing_latch_deferred) {
+      homing_latch_deferred = false;
+      limits_homing_latch(); // Position now includes the steps of this tick.
+    }
   #endif
+
   busy = false;
 }
 
 
+#ifdef HOMING_LATCH_TRIGGER_POSITION
+  // The stepper ISR re-enables interrupts before it updates sys_position, so the limit pin change
+  // interrupt may find the position counters half written. Leave the latch to the stepper ISR then.
+  void st_homing_latch()
+  {
+    if (busy) { homing_latch_deferred = true; }
+    else { limits_homing_latch(); }
+  }
+#endif
+
+
 /* The Stepper Port Reset Interrupt: Timer0 OVF interrupt handles the falling edge of the step
    pulse. This should always trigger before the next Timer1 COMPA interrupt and independently
    finish, if Timer1 is disabled after completing a move.
@@ -601,6 +907,21 @@ static uint8_t st_next_block_index(uint8_t block_index)
 }
 
 
+#ifdef ENABLE_DUAL_AXIS
+  // Sets the dual motor direction bits of a prepped stepper block from its direction bits.
+  static void st_set_direction_bits_dual(st_block_t *block)
+  {
+    #if (DUAL_AXIS_SELECT == X_AXIS)
+      if (block->direction_bits & (1<<X_DIRECTION_BIT)) { 
+    #elif (DUAL_AXIS_SELECT == Y_AXIS)
+      if (block->direction_bits & (1<<Y_DIRECTION_BIT)) { 
+    #endif
+      block->direction_bits_dual = (1<<DIRECTION_DUAL_BIT); 
+    }  else { block->direction_bits_dual = 0; }
+  }
+#endif
+
+
 #ifdef PARKING_ENABLE
   // Changes the run state of the step segment buffer to execute the special parking motion.
   void st_parking_setup_buffer()
@@ -611,6 +932,9 @@ static uint8_t st_next_block_index(uint8_t block_index)
       prep.last_steps_remaining = prep.steps_remaining;
       prep.last_dt_remainder = prep.dt_remainder;
       prep.last_step_per_mm = prep.step_per_mm;
+      #ifdef DDA_STEP_ENGINE
+        memcpy(prep.last_dda_steps_done, prep.dda_steps_done, sizeof(prep.dda_steps_done));
+      #endif
     }
     // Set flags to execute a parking motion
     prep.recalculate_flag |= PREP_FLAG_PARKING;
@@ -629,8 +953,15 @@ static uint8_t st_next_block_index(uint8_t block_index)
       prep.steps_remaining = prep.last_steps_remaining;
       prep.dt_remainder = prep.last_dt_remainder;
       prep.step_per_mm = prep.last_step_per_mm;
+      #ifdef DDA_STEP_ENGINE
+        memcpy(prep.dda_steps_done, prep.last_dda_steps_done, sizeof(prep.dda_steps_done));
+      #endif
       prep.recalculate_flag = (PREP_FLAG_HOLD_PARTIAL_BLOCK | PREP_FLAG_RECALCULATE);
-      prep.req_mm_increment = REQ_MM_INCREMENT_SCALAR/prep.step_per_mm; // Recompute this value.
+      #ifdef FIXED_POINT_SEGMENT_GENERATOR
+        prep.req_mm_increment = (REQ_MM_INCREMENT_SCALAR*STEP_FRAC_ONE)/prep.step_per_mm; // Recompute this value.
+      #else
+        prep.req_mm_increment = REQ_MM_INCREMENT_SCALAR/prep.step_per_mm; // Recompute this value.
+      #endif
     } else {
       prep.recalculate_flag = false;
     }
@@ -639,6 +970,268 @@ static uint8_t st_next_block_index(uint8_t block_index)
 #endif
 
 
+#ifdef FIXED_POINT_SEGMENT_GENERATOR
+  // Reciprocal seeds 2^30/m for m in [2^15,2^16), indexed by the six bits below the leading one.
+  static const uint16_t st_recip_table[64] PROGMEM = {
+    32514, 32018, 31536, 31069, 30615, 30175, 29747, 29331, 28926, 28533, 28150, 27777, 27414,
+    27060, 26715, 26379, 26052, 25732, 25420, 25116, 24818, 24528, 24245, 23967, 23697, 23432,
+    23173, 22920, 22672, 22429, 22192, 21960, 21732, 21509, 21291, 21077, 20867, 20662, 20460,
+    20262, 20068, 19878, 19692, 19508, 19329, 19152, 18979, 18809, 18641, 18477, 18316, 18157,
+    18001, 17848, 17697, 17549, 17404, 17261, 17120, 16981, 16845, 16710, 16578, 16448 };
+
+  // Inverse square root seeds 2^14/sqrt(m/2^16) for m in [2^14,2^16), indexed by (m>>10)-16.
+  static const uint16_t st_rsqrt_table[48] PROGMEM = {
+    32268, 31332, 30474, 29682, 28949, 28268, 27632, 27038, 26481, 25956, 25462, 24994, 24552,
+    24132, 23733, 23354, 22992, 22646, 22315, 21999, 21695, 21404, 21124, 20855, 20596, 20346,
+    20106, 19873, 19649, 19431, 19221, 19018, 18821, 18630, 18444, 18264, 18090, 17920, 17755,
+    17594, 17438, 17285, 17137, 16992, 16851, 16714, 16579, 16448 };
+
+
+  // Returns 2^30/m for a normalized m in [2^15,2^16). One Newton step refines the table seed to
+  // the 15 bits of the result.
+  static uint16_t st_fixed_recip(uint16_t m)
+  {
+    uint16_t r = pgm_read_word(&st_recip_table[(m >> 9) & 0x3f]);
+    uint32_t e = (1UL << 31) - (uint32_t)m*r; // (2 - m*r) in Q30
+    return(((uint32_t)r*(e >> 15)) >> 15);
+  }
+
+
+  // Returns (a*r) >> shift, truncated, for shifts of 15 to 47. Multiplies by 16-bit halves to keep
+  // within 32 bits. The result must fit in 32 bits.
+  static uint32_t st_fixed_mul_shift(uint32_t a, uint16_t r, uint8_t shift)
+  {
+    uint32_t hi = (a >> 16)*r;
+    uint32_t lo = (a & 0xffff)*r;
+    if (shift < 16) { return((hi << 1) + (lo >> 15)); }
+    uint32_t result = hi >> (shift-16);
+    if (shift < 32) { result += lo >> shift; }
+    return(result);
+  }
+
+
+  // Computes the timer cycles per step of a segment from its execution time in cycles and its
+  // Q24.8 step distance. Rounds up like the float ceil(). Step distance must be at least one step.
+  // The 15-bit reciprocal alone is up to 2^-14 low, which is a cycle per step at the step rates
+  // used and adds up to steps over a motion. So the estimate is corrected by the reciprocal of its
+  // residual time and then stepped to the exact quotient. The residual is small, so it is computed
+  // exactly with wrapping 32-bit products, even where the time in Q24.8 cycles would not fit.
+  static uint32_t st_fixed_cycles_per_step(uint32_t dt_cycles, uint32_t step_dist)
+  {
+    // Normalize step distance to m*2^(bit_pos-15), with m in [2^15,2^16).
+    uint32_t m = step_dist;
+    uint8_t bit_pos = 15;
+    while (m >= (1UL << 16)) { m >>= 1; bit_pos++; }
+    while (m < (1UL << 15)) { m <<= 1; bit_pos--; }
+    uint16_t r = st_fixed_recip(m);
+    uint32_t cycles = st_fixed_mul_shift(dt_cycles, r, bit_pos+7); // dt_cycles*2^8/step_dist
+    int32_t residual = (dt_cycles << STEP_FRAC_BITS) - cycles*step_dist;
+    if (residual < 0) { cycles -= st_fixed_mul_shift(-residual, r, bit_pos+15); }
+    else { cycles += st_fixed_mul_shift(residual, r, bit_pos+15); }
+    residual = (dt_cycles << STEP_FRAC_BITS) - cycles*step_dist;
+    while (residual < 0) { cycles--; residual += step_dist; }
+    while ((uint32_t)residual >= step_dist) { cycles++; residual -= step_dist; }
+    if (residual) { cycles++; } // Round-up
+    return(cycles);
+  }
+
+
+  // Integer square root of q, seeded by inverse square root table and two multiply-only Newton steps.
+  static uint32_t st_fixed_isqrt(uint32_t q)
+  {
+    if (q == 0) { return(0); }
+    uint8_t shift = 0;
+    while (q < (1UL << 30)) { q <<= 2; shift++; }
+    uint16_t m = q >> 16;
+    uint16_t y = pgm_read_word(&st_rsqrt_table[(m >> 10)-16]); // 1/sqrt(m/2^16) in Q14
+    uint8_t i;
+    for (i=0; i<2; i++) {
+      uint32_t y_sqr = ((uint32_t)y*y) >> 14;
+      y = ((uint32_t)y*((3UL << 14) - (((uint32_t)m*y_sqr) >> 16))) >> 15;
+    }
+    q = ((uint32_t)m*y) >> 14; // sqrt(m*2^16)
+    if (shift) { q = (q + (1UL << (shift-1))) >> shift; }
+    return(q);
+  }
+
+
+  // Square root of a speed squared (mm/min)^2 for the velocity profile. Converts to the Q-format
+  // with the most fractional bits the magnitude allows, so slow speeds retain their resolution.
+  static float st_fixed_sqrt(float x)
+  {
+    if (x <= 0.0) { return(0.0); }
+    if (x < 256.0) { return(st_fixed_isqrt(x*16777216.0)*(1.0/4096.0)); }
+    if (x < 65536.0) { return(st_fixed_isqrt(x*65536.0)*(1.0/256.0)); }
+    if (x < 16777216.0) { return(st_fixed_isqrt(x*256.0)*(1.0/16.0)); }
+    if (x < 4294967296.0) { return(st_fixed_isqrt(x)); }
+    if (x < 1099511627776.0) { return(st_fixed_isqrt(x*(1.0/256.0))*16.0); }
+    return(1048576.0); // Beyond any realizable speed. Saturate.
+  }
+#endif
+
+
+#ifdef NATIVE_ARC_BLOCKS
+  // Initializes the segment generator to trace the arc of a newly loaded planner block.
+  static void st_prep_arc_block()
+  {
+    plan_arc_data_t *arc = &pl_block->arc;
+    prep.arc_inv_length = 1.0/pl_block->millimeters;
+    prep.arc_start[0] = arc->radius*cos(arc->angle_start);
+    prep.arc_start[1] = arc->radius*sin(arc->angle_start);
+    memset(prep.arc_steps, 0, sizeof(prep.arc_steps));
+    st_prep_block->step_event_count = 0; // Never executed. Flags the stepper block free for the first chord.
+
+    // Same chord length as the line segments of a split arc, scaled to the helix path length.
+    float chord_sqr = settings.arc_tolerance*(2*arc->radius - settings.arc_tolerance);
+    if (chord_sqr > 0.0) {
+      prep.arc_segment_mm = 2*sqrt(chord_sqr)*pl_block->millimeters/fabs(arc->radius*arc->angular_travel);
+    } else {
+      prep.arc_segment_mm = pl_block->millimeters;
+    }
+
+    // The coarsest plane axis sets the minimum segment distance for a step.
+    prep.step_per_mm = min(settings.steps_per_mm[arc->axis_0], settings.steps_per_mm[arc->axis_1]);
+    #ifdef FIXED_POINT_SEGMENT_GENERATOR
+      prep.step_per_mm *= STEP_FRAC_ONE;
+      prep.req_mm_increment = (REQ_MM_INCREMENT_SCALAR*STEP_FRAC_ONE)/prep.step_per_mm;
+    #else
+      prep.req_mm_increment = REQ_MM_INCREMENT_SCALAR/prep.step_per_mm;
+    #endif
+  }
+
+
+  // Computes the chord from the last prepped arc point to the arc point mm_remaining from the end of
+  // the arc block in steps. Returns the number of step events of the chord.
+  static uint16_t st_arc_chord(float mm_remaining, int32_t *chord)
+  {
+    plan_arc_data_t *arc = &pl_block->arc;
+    int32_t arc_point[N_AXIS];
+    uint8_t idx;
+    if (mm_remaining == 0.0) {
+      // Arc end point. Use the planned steps, so the block ends exactly at the planner position.
+      for (idx=0; idx<N_AXIS; idx++) {
+        arc_point[idx] = pl_block->steps[idx];
+        if (pl_block->direction_bits & get_direction_pin_mask(idx)) { arc_point[idx] = -arc_point[idx]; }
+      }
+    } else {
+      float arc_fraction = 1.0 - mm_remaining*prep.arc_inv_length;
+      float angle = arc->angle_start + arc_fraction*arc->angular_travel;
+      arc_point[arc->axis_0] = lround((arc->radius*cos(angle)-prep.arc_start[0])*settings.steps_per_mm[arc->axis_0]);
+      arc_point[arc->axis_1] = lround((arc->radius*sin(angle)-prep.arc_start[1])*settings.steps_per_mm[arc->axis_1]);
+      arc_point[arc->axis_linear] = lround(arc_fraction*arc->linear_travel*settings.steps_per_mm[arc->axis_linear]);
+    }
+    uint32_t step_event_count = 0;
+    for (idx=0; idx<N_AXIS; idx++) {
+      chord[idx] = arc_point[idx] - prep.arc_steps[idx];
+      step_event_count = max(step_event_count, labs(chord[idx]));
+    }
+    return(step_event_count);
+  }
+
+
+  // Loads an arc segment chord as a new stepper block, as the block load does for line blocks.
+  // NOTE: Segments in the buffer may reference every other stepper block, so the first chord must
+  // take the stepper block of the arc block load.
+  static void st_prep_arc_chord(int32_t *chord, uint16_t step_event_count)
+  {
+    if (st_prep_block->step_event_count) {
+      prep.st_block_index = st_next_block_index(prep.st_block_index);
+      st_block_t *chord_block = &st_block_buffer[prep.st_block_index];
+      #ifdef VARIABLE_SPINDLE
+        chord_block->is_pwm_rate_adjusted = st_prep_block->is_pwm_rate_adjusted;
+      #endif
+      #ifdef PLANNED_ACCESSORY_STATE
+        chord_block->accessory_update = false; // Applied by the first chord only. Slot may be stale.
+      #endif
+      st_prep_block = chord_block;
+    }
+    st_prep_block->direction_bits = 0;
+    uint8_t idx;
+    for (idx=0; idx<N_AXIS; idx++) {
+      prep.arc_steps[idx] += chord[idx];
+      if (chord[idx] < 0) { st_prep_block->direction_bits |= get_direction_pin_mask(idx); }
+      #ifdef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
+        st_prep_block->steps[idx] = labs(chord[idx]) << MAX_AMASS_LEVEL;
+      #else
+        st_prep_block->steps[idx] = labs(chord[idx]) << 1;
+      #endif
+    }
+    #ifdef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
+      st_prep_block->step_event_count = (uint32_t)step_event_count << MAX_AMASS_LEVEL;
+    #else
+      st_prep_block->step_event_count = (uint32_t)step_event_count << 1;
+    #endif
+    #ifdef ENABLE_DUAL_AXIS
+      st_set_direction_bits_dual(st_prep_block);
+    #endif
+  }
+
+
+  // Computes the CPU cycles per step of an arc segment. Chords end on whole steps, so there is no
+  // partial step time to track, only the time of preceding segments without a step.
+  static uint32_t st_arc_segment_cycles(uint16_t n_step, float dt)
+  {
+    #ifdef FIXED_POINT_SEGMENT_GENERATOR
+      uint32_t dt_cycles = (uint32_t)(dt*CYCLES_PER_MINUTE) + prep.dt_remainder;
+      if (n_step == 0) { prep.dt_remainder = dt_cycles; return(0); }
+      prep.dt_remainder = 0;
+      return(dt_cycles/n_step);
+    #else
+      dt += prep.dt_remainder;
+      if (n_step == 0) { prep.dt_remainder = dt; return(0); }
+      prep.dt_remainder = 0.0;
+      return(ceil((TICKS_PER_MICROSECOND*1000000*60.0)*dt/n_step));
+    #endif
+  }
+#endif
+
+
+#ifdef PLAN_DWELL_BLOCKS
+  // Prepares an idle segment of the dwell block being prepped. The segment executes its ticks through
+  // a stepper block without steps, so the Stepper Driver Interrupt times the dwell like a motion.
+  static void st_prep_dwell_segment()
+  {
+    segment_t *prep_segment = &segment_buffer[segment_buffer_head];
+    prep_segment->st_block_index = prep.st_block_index;
+
+    uint16_t dwell_ms = pl_block->dwell_ms;
+    if (dwell_ms > DWELL_MS_PER_SEGMENT) { dwell_ms = DWELL_MS_PER_SEGMENT; }
+    #ifdef DDA_STEP_ENGINE
+      memset(prep_segment->dda_quota, 0, sizeof(prep_segment->dda_quota));
+      memset(prep_segment->dda_inc, 0, sizeof(prep_segment->dda_inc));
+      prep_segment->n_step = ((uint32_t)dwell_ms*(F_CPU/1000))/DDA_TICK_CYCLES;
+      prep_segment->cycles_per_tick = DDA_TICK_CYCLES;
+    #else
+      prep_segment->n_step = dwell_ms*DWELL_TICKS_PER_MS;
+      prep_segment->cycles_per_tick = DWELL_TICK_CYCLES;
+    #endif
+    #ifdef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
+      prep_segment->amass_level = 0;
+    #elif SPT_PERIOD_BITS <= 16
+      prep_segment->prescaler = 1; // prescaler: 0
+    #endif
+    #ifdef STEP_BURST_MODE
+      prep_segment->burst_level = 0;
+    #endif
+    #ifdef VARIABLE_SPINDLE
+      // Rate adjusted laser power is off without motion.
+      if (st_prep_block->is_pwm_rate_adjusted) { prep_segment->spindle_pwm = SPINDLE_PWM_OFF_VALUE; }
+      else { prep_segment->spindle_pwm = prep.current_spindle_pwm; }
+    #endif
+    prep.current_speed = 0.0;
+
+    segment_buffer_head = segment_next_head;
+    if ( ++segment_next_head == SEGMENT_BUFFER_SIZE ) { segment_next_head = 0; }
+
+    pl_block->dwell_ms -= dwell_ms;
+    if (pl_block->dwell_ms == 0) {
+      pl_block = NULL;
+      plan_discard_current_block();
+    }
+  }
+#endif
+
+
 /* Prepares step segment buffer. Continuously called from main program.
 
    The segment buffer is an intermediary buffer interface between the execution of steps
@@ -688,16 +1281,25 @@ void st_prep_buffer()
         st_prep_block = &st_block_buffer[prep.st_block_index];
         st_prep_block->direction_bits = pl_block->direction_bits;
         #ifdef ENABLE_DUAL_AXIS
-          #if (DUAL_AXIS_SELECT == X_AXIS)
-            if (st_prep_block->direction_bits & (1<<X_DIRECTION_BIT)) { 
-          #elif (DUAL_AXIS_SELECT == Y_AXIS)
-            if (st_prep_block->direction_bits & (1<<Y_DIRECTION_BIT)) { 
-          #endif
-            st_prep_block->direction_bits_dual = (1<<DIRECTION_DUAL_BIT); 
-          }  else { st_prep_block->direction_bits_dual = 0; }
+          st_set_direction_bits_dual(st_prep_block);
         #endif
         uint8_t idx;
-        #ifndef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
+        #ifdef ENABLE_BACKLASH_COMPENSATION
+          for (idx=0; idx<N_AXIS; idx++) {
+            if (pl_block->is_backlash) { st_prep_block->position_step[idx] = 0; }
+            else if (pl_block->direction_bits & get_direction_pin_mask(idx)) { st_prep_block->position_step[idx] = -1; }
+            else { st_prep_block->position_step[idx] = 1; }
+          }
+        #endif
+        #if defined(DDA_STEP_ENGINE)
+          // The DDA engine uses the block steps only to check-out exact step quotas per segment.
+          for (idx=0; idx<N_AXIS; idx++) {
+            st_prep_block->steps[idx] = pl_block->steps[idx];
+            prep.dda_steps_done[idx] = 0;
+            prep.dda_step_ratio[idx] = (float)pl_block->steps[idx]/pl_block->step_event_count;
+          }
+          st_prep_block->step_event_count = pl_block->step_event_count;
+        #elif !defined(ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING)
           for (idx=0; idx<N_AXIS; idx++) { st_prep_block->steps[idx] = (pl_block->steps[idx] << 1); }
           st_prep_block->step_event_count = (pl_block->step_event_count << 1);
         #else
@@ -709,10 +1311,20 @@ void st_prep_buffer()
         #endif
 
         // Initialize segment buffer data for generating the segments.
-        prep.steps_remaining = (float)pl_block->step_event_count;
-        prep.step_per_mm = prep.steps_remaining/pl_block->millimeters;
-        prep.req_mm_increment = REQ_MM_INCREMENT_SCALAR/prep.step_per_mm;
-        prep.dt_remainder = 0.0; // Reset for new segment block
+        #ifdef FIXED_POINT_SEGMENT_GENERATOR
+          prep.steps_remaining = pl_block->step_event_count;
+          prep.step_per_mm = (STEP_FRAC_ONE*(float)prep.steps_remaining)/pl_block->millimeters;
+          prep.req_mm_increment = (REQ_MM_INCREMENT_SCALAR*STEP_FRAC_ONE)/prep.step_per_mm;
+          prep.dt_remainder = 0; // Reset for new segment block
+        #else
+          prep.steps_remaining = (float)pl_block->step_event_count;
+          prep.step_per_mm = prep.steps_remaining/pl_block->millimeters;
+          prep.req_mm_increment = REQ_MM_INCREMENT_SCALAR/prep.step_per_mm;
+          prep.dt_remainder = 0.0; // Reset for new segment block
+        #endif
+        #ifdef NATIVE_ARC_BLOCKS
+          if (pl_block->is_arc) { st_prep_arc_block(); }
+        #endif
 
         if ((sys.step_control & STEP_CONTROL_EXECUTE_HOLD) || (prep.recalculate_flag & PREP_FLAG_DECEL_OVERRIDE)) {
           // New block loaded mid-hold. Override planner block entry speed to enforce deceleration.
@@ -720,7 +1332,7 @@ void st_prep_buffer()
           pl_block->entry_speed_sqr = prep.exit_speed*prep.exit_speed;
           prep.recalculate_flag &= ~(PREP_FLAG_DECEL_OVERRIDE);
         } else {
-          prep.current_speed = sqrt(pl_block->entry_speed_sqr);
+          prep.current_speed = st_sqrt(pl_block->entry_speed_sqr);
         }
         
         #ifdef VARIABLE_SPINDLE
@@ -735,6 +1347,20 @@ void st_prep_buffer()
             }
           }
         #endif
+
+        #ifdef PLANNED_ACCESSORY_STATE
+          // Flag a spindle or coolant change for the stepper ISR. Homing and parking motions leave the
+          // outputs to their own routines.
+          st_prep_block->accessory_update = false;
+          if (!(pl_block->condition & PL_COND_FLAG_SYSTEM_MOTION)) {
+            uint8_t accessory_state = pl_block->condition & PL_COND_ACCESSORY_MASK;
+            if (accessory_state != prep.accessory_state) {
+              prep.accessory_state = accessory_state;
+              st_prep_block->accessory_state = accessory_state;
+              st_prep_block->accessory_update = true;
+            }
+          }
+        #endif
       }
 
 			/* ---------------------------------------------------------------------------------
@@ -753,7 +1379,7 @@ void st_prep_buffer()
 				float decel_dist = pl_block->millimeters - inv_2_accel*pl_block->entry_speed_sqr;
 				if (decel_dist < 0.0) {
 					// Deceleration through entire planner block. End of feed hold is not in this block.
-					prep.exit_speed = sqrt(pl_block->entry_speed_sqr-2*pl_block->acceleration*pl_block->millimeters);
+					prep.exit_speed = st_sqrt(pl_block->entry_speed_sqr-2*pl_block->acceleration*pl_block->millimeters);
 				} else {
 					prep.mm_complete = decel_dist; // End of feed hold.
 					prep.exit_speed = 0.0;
@@ -769,7 +1395,7 @@ void st_prep_buffer()
           prep.exit_speed = exit_speed_sqr = 0.0; // Enforce stop at end of system motion.
         } else {
           exit_speed_sqr = plan_get_exec_block_exit_speed_sqr();
-          prep.exit_speed = sqrt(exit_speed_sqr);
+          prep.exit_speed = st_sqrt(exit_speed_sqr);
         }
 
         nominal_speed = plan_compute_profile_nominal_speed(pl_block);
@@ -785,7 +1411,7 @@ void st_prep_buffer()
             // prep.maximum_speed = prep.current_speed;
 
             // Compute override block exit speed since it doesn't match the planner exit speed.
-            prep.exit_speed = sqrt(pl_block->entry_speed_sqr - 2*pl_block->acceleration*pl_block->millimeters);
+            prep.exit_speed = st_sqrt(pl_block->entry_speed_sqr - 2*pl_block->acceleration*pl_block->millimeters);
             prep.recalculate_flag |= PREP_FLAG_DECEL_OVERRIDE; // Flag to load next block as deceleration override.
 
             // TODO: Determine correct handling of parameters in deceleration-only.
@@ -814,7 +1440,7 @@ void st_prep_buffer()
 						} else { // Triangle type
 							prep.accelerate_until = intersect_distance;
 							prep.decelerate_after = intersect_distance;
-							prep.maximum_speed = sqrt(2.0*pl_block->acceleration*intersect_distance+exit_speed_sqr);
+							prep.maximum_speed = st_sqrt(2.0*pl_block->acceleration*intersect_distance+exit_speed_sqr);
 						}
 					} else { // Deceleration-only type
             prep.ramp_type = RAMP_DECEL;
@@ -833,6 +1459,21 @@ void st_prep_buffer()
       #endif
     }
     
+    #ifdef PLAN_DWELL_BLOCKS
+      if (pl_block->dwell_ms) {
+        // A feed hold stops a dwell immediately. The remaining time executes after resuming.
+        if (sys.step_control & STEP_CONTROL_EXECUTE_HOLD) {
+          bit_true(sys.step_control,STEP_CONTROL_END_MOTION);
+          #ifdef PARKING_ENABLE
+            if (!(prep.recalculate_flag & PREP_FLAG_PARKING)) { prep.recalculate_flag |= PREP_FLAG_HOLD_PARTIAL_BLOCK; }
+          #endif
+          return;
+        }
+        st_prep_dwell_segment();
+        continue;
+      }
+    #endif
+
     // Initialize new segment
     segment_t *prep_segment = &segment_buffer[segment_buffer_head];
 
@@ -854,6 +1495,14 @@ void st_prep_buffer()
       such as from a feed hold.
     */
     float dt_max = DT_SEGMENT; // Maximum segment time
+    #ifdef NATIVE_ARC_BLOCKS
+      if (pl_block->is_arc) {
+        // Shorten the segment time to keep the segment chord within the arc tolerance. Bounded by the
+        // fastest speed reachable in the segment.
+        float arc_speed = prep.current_speed + pl_block->acceleration*DT_SEGMENT;
+        if (arc_speed*dt_max > prep.arc_segment_mm) { dt_max = prep.arc_segment_mm/arc_speed; }
+      }
+    #endif
     float dt = 0.0; // Initialize segment time
     float time_var = dt_max; // Time worker variable
     float mm_var; // mm-Distance worker variable
@@ -960,47 +1609,171 @@ void st_prep_buffer()
 
     #endif
     
-    /* -----------------------------------------------------------------------------------
-       Compute segment step rate, steps to execute, and apply necessary rate corrections.
-       NOTE: Steps are computed by direct scalar conversion of the millimeter distance
-       remaining in the block, rather than incrementally tallying the steps executed per
-       segment. This helps in removing floating point round-off issues of several additions.
-       However, since floats have only 7.2 significant digits, long moves with extremely
-       high step counts can exceed the precision of floats, which can lead to lost steps.
-       Fortunately, this scenario is highly unlikely and unrealistic in CNC machines
-       supported by Grbl (i.e. exceeding 10 meters axis travel at 200 step/mm).
-    */
-    float step_dist_remaining = prep.step_per_mm*mm_remaining; // Convert mm_remaining to steps
-    float n_steps_remaining = ceil(step_dist_remaining); // Round-up current steps remaining
-    float last_n_steps_remaining = ceil(prep.steps_remaining); // Round-up last steps remaining
-    prep_segment->n_step = last_n_steps_remaining-n_steps_remaining; // Compute number of steps to execute.
-
-    // Bail if we are at the end of a feed hold and don't have a step to execute.
-    if (prep_segment->n_step == 0) {
-      if (sys.step_control & STEP_CONTROL_EXECUTE_HOLD) {
-        // Less than one step to decelerate to zero speed, but already very close. AMASS
-        // requires full steps to execute. So, just bail.
-        bit_true(sys.step_control,STEP_CONTROL_END_MOTION);
-        #ifdef PARKING_ENABLE
-          if (!(prep.recalculate_flag & PREP_FLAG_PARKING)) { prep.recalculate_flag |= PREP_FLAG_HOLD_PARTIAL_BLOCK; }
-        #endif
-        return; // Segment not generated, but current step data still retained.
+    uint32_t cycles; // CPU cycles per step for the prepped segment.
+    #ifdef NATIVE_ARC_BLOCKS
+    if (pl_block->is_arc) {
+      /* -----------------------------------------------------------------------------------
+         Compute the chord steps from the last prepped arc point to the true arc point at
+         mm_remaining. Every arc segment executes its chord as a new stepper block. Segments
+         without a step are not executed, but carry their time into the next segment.
+      */
+      int32_t arc_chord[N_AXIS];
+      prep_segment->n_step = st_arc_chord(mm_remaining, arc_chord);
+      if (prep_segment->n_step == 0) {
+        if (sys.step_control & STEP_CONTROL_EXECUTE_HOLD) {
+          // At the end of a feed hold with no step to execute. Bail as with line blocks.
+          bit_true(sys.step_control,STEP_CONTROL_END_MOTION);
+          #ifdef PARKING_ENABLE
+            if (!(prep.recalculate_flag & PREP_FLAG_PARKING)) { prep.recalculate_flag |= PREP_FLAG_HOLD_PARTIAL_BLOCK; }
+          #endif
+          return;
+        }
+      } else {
+        st_prep_arc_chord(arc_chord, prep_segment->n_step);
+        prep_segment->st_block_index = prep.st_block_index;
+      }
+      cycles = st_arc_segment_cycles(prep_segment->n_step, dt);
+    } else
+    #endif
+    {
+      /* -----------------------------------------------------------------------------------
+         Compute segment step rate, steps to execute, and apply necessary rate corrections.
+         NOTE: Steps are computed by direct scalar conversion of the millimeter distance
+         remaining in the block, rather than incrementally tallying the steps executed per
+         segment. This helps in removing floating point round-off issues of several additions.
+         However, since floats have only 7.2 significant digits, long moves with extremely
+         high step counts can exceed the precision of floats, which can lead to lost steps.
+         Fortunately, this scenario is highly unlikely and unrealistic in CNC machines
+         supported by Grbl (i.e. exceeding 10 meters axis travel at 200 step/mm).
+      */
+      #ifdef FIXED_POINT_SEGMENT_GENERATOR
+        // NOTE: The Q24.8 conversion rounds up, so any distance left is a step left, as with ceil().
+        // Truncating a distance below 1/256 step left a final segment without steps, which the ISR
+        // executes as 65536 ticks. Float round-off may still end a segment one step early or late
+        // compared to the float version. Blocks start and end on whole steps, so the block total is exact.
+        float step_dist = prep.step_per_mm*mm_remaining;
+        uint32_t step_dist_remaining = step_dist; // Convert mm_remaining to Q24.8 steps
+        if (step_dist > step_dist_remaining) { step_dist_remaining++; } // Round-up
+        uint32_t n_steps_remaining = (step_dist_remaining+(STEP_FRAC_ONE-1)) >> STEP_FRAC_BITS; // Round-up
+        uint32_t last_n_steps_remaining = prep.steps_remaining; // Always whole steps.
+      #else
+        float step_dist_remaining = prep.step_per_mm*mm_remaining; // Convert mm_remaining to steps
+        float n_steps_remaining = ceil(step_dist_remaining); // Round-up current steps remaining
+        float last_n_steps_remaining = ceil(prep.steps_remaining); // Round-up last steps remaining
+      #endif
+      prep_segment->n_step = last_n_steps_remaining-n_steps_remaining; // Compute number of steps to execute.
+
+      // Bail if we are at the end of a feed hold and don't have a step to execute.
+      if (prep_segment->n_step == 0) {
+        if (sys.step_control & STEP_CONTROL_EXECUTE_HOLD) {
+          // Less than one step to decelerate to zero speed, but already very close. AMASS
+          // requires full steps to execute. So, just bail.
+          bit_true(sys.step_control,STEP_CONTROL_END_MOTION);
+          #ifdef PARKING_ENABLE
+            if (!(prep.recalculate_flag & PREP_FLAG_PARKING)) { prep.recalculate_flag |= PREP_FLAG_HOLD_PARTIAL_BLOCK; }
+          #endif
+          return; // Segment not generated, but current step data still retained.
+        }
       }
+
+      // Compute segment step rate. Since steps are integers and mm distances traveled are not,
+      // the end of every segment can have a partial step of varying magnitudes that are not
+      // executed, because the stepper ISR requires whole steps due to the AMASS algorithm. To
+      // compensate, we track the time to execute the previous segment's partial step and simply
+      // apply it with the partial step distance to the current segment, so that it minutely
+      // adjusts the whole segment rate to keep step output exact. These rate adjustments are
+      // typically very small and do not adversely effect performance, but ensures that Grbl
+      // outputs the exact acceleration and velocity profiles as computed by the planner.
+      #ifdef FIXED_POINT_SEGMENT_GENERATOR
+        uint32_t dt_cycles = (uint32_t)(dt*CYCLES_PER_MINUTE+0.5) + prep.dt_remainder; // Apply previous partial step time
+        uint32_t step_dist_executed = (last_n_steps_remaining << STEP_FRAC_BITS) - step_dist_remaining;
+        if (step_dist_executed < STEP_FRAC_ONE) { step_dist_executed = STEP_FRAC_ONE; } // Zero-step segments only.
+
+        // Compute CPU cycles per step for the prepped segment.
+        cycles = st_fixed_cycles_per_step(dt_cycles, step_dist_executed); // (cycles/step)
+
+        // Time to execute this segment's partial step, carried into the next segment.
+        uint32_t step_frac = (n_steps_remaining << STEP_FRAC_BITS) - step_dist_remaining; // < STEP_FRAC_ONE
+        uint32_t dt_remainder;
+        if (cycles < (1UL << (32-STEP_FRAC_BITS))) { dt_remainder = (step_frac*cycles) >> STEP_FRAC_BITS; }
+        else { dt_remainder = step_frac*(cycles >> STEP_FRAC_BITS); }
+      #else
+        dt += prep.dt_remainder; // Apply previous segment partial step execute time
+        float inv_rate = dt/(last_n_steps_remaining - step_dist_remaining); // Compute adjusted step rate inverse
+
+        // Compute CPU cycles per step for the prepped segment.
+        cycles = ceil( (TICKS_PER_MICROSECOND*1000000*60.0)*inv_rate ); // (cycles/step)
+      #endif
+
+      // Update the appropriate segment data.
+      prep.steps_remaining = n_steps_remaining;
+      #ifdef FIXED_POINT_SEGMENT_GENERATOR
+        prep.dt_remainder = dt_remainder;
+      #else
+        prep.dt_remainder = (n_steps_remaining - step_dist_remaining)*inv_rate;
+      #endif
     }
 
-    // Compute segment step rate. Since steps are integers and mm distances traveled are not,
-    // the end of every segment can have a partial step of varying magnitudes that are not
-    // executed, because the stepper ISR requires whole steps due to the AMASS algorithm. To
-    // compensate, we track the time to execute the previous segment's partial step and simply
-    // apply it with the partial step distance to the current segment, so that it minutely
-    // adjusts the whole segment rate to keep step output exact. These rate adjustments are
-    // typically very small and do not adversely effect performance, but ensures that Grbl
-    // outputs the exact acceleration and velocity profiles as computed by the planner.
-    dt += prep.dt_remainder; // Apply previous segment partial step execute time
-    float inv_rate = dt/(last_n_steps_remaining - step_dist_remaining); // Compute adjusted step rate inverse
+    #ifdef DDA_STEP_ENGINE
+      /* -----------------------------------------------------------------------------------
+         Convert the segment into fixed-frequency DDA ticks. The segment time is issued as whole
+         ticks, carrying the remainder forward. Each axis gets its exact step quota for the segment
+         from its block step ratio, so block step totals stay exact, and a phase increment that
+         spreads the quota evenly over the segment ticks.
+      */
+      uint32_t dda_cycles = prep_segment->n_step*cycles + prep.dda_cycle_remainder;
+      uint32_t dda_ticks = dda_cycles/DDA_TICK_CYCLES;
+      prep.dda_cycle_remainder = dda_cycles - dda_ticks*DDA_TICK_CYCLES;
+      uint32_t dda_steps_done = st_prep_block->step_event_count - prep.steps_remaining;
+      uint16_t dda_max_quota = 0;
+      uint8_t idx;
+      for (idx=0; idx<N_AXIS; idx++) {
+        uint32_t steps_target;
+        if (prep.steps_remaining == 0) { steps_target = st_prep_block->steps[idx]; } // Exact at end of block.
+        else { steps_target = dda_steps_done*prep.dda_step_ratio[idx]; }
+        prep_segment->dda_quota[idx] = steps_target - prep.dda_steps_done[idx];
+        prep.dda_steps_done[idx] = steps_target;
+        if (prep_segment->dda_quota[idx] > dda_max_quota) { dda_max_quota = prep_segment->dda_quota[idx]; }
+      }
+      // An axis steps at most once per tick. Stretch the segment, if it exceeds the DDA frequency.
+      if (dda_ticks <= dda_max_quota) { dda_ticks = dda_max_quota+1; }
+      else if (dda_ticks > 0xffff) { dda_ticks = 0xffff; } // Just set the slowest speed possible.
+      float inc_per_step = 4294967296.0/dda_ticks; // Phase increment per step of quota.
+      for (idx=0; idx<N_AXIS; idx++) {
+        float inc = prep_segment->dda_quota[idx]*inc_per_step;
+        // NOTE: Clamped below 2^32. The ISR forces any step still owed on the last segment tick.
+        if (inc < 4294967040.0) { prep_segment->dda_inc[idx] = inc; }
+        else { prep_segment->dda_inc[idx] = 4294967040UL; }
+      }
+      prep_segment->n_step = dda_ticks;
+      prep_segment->cycles_per_tick = DDA_TICK_CYCLES;
+      #if SPT_PERIOD_BITS <= 16
+        prep_segment->prescaler = 1; // prescaler: 0
+      #endif
+    #else
 
-    // Compute CPU cycles per step for the prepped segment.
-    uint32_t cycles = ceil( (TICKS_PER_MICROSECOND*1000000*60.0)*inv_rate ); // (cycles/step)
+    #ifdef STEP_BURST_MODE
+      // Above the burst cutoff frequency, group steps into bursts of 2^burst_level per ISR tick. The
+      // tick period is the burst length times the step period, which keeps it under the AMASS cutoffs.
+      // NOTE: The timer period is one cycle longer than its compare value, which single steps take
+      // once per step. Burst ticks add it for each step of the burst to keep the same step rate.
+      prep_segment->burst_level = 0;
+      while ((cycles < STEP_BURST_CYCLES) && (prep_segment->burst_level < STEP_BURST_MAX_LEVEL)) {
+        cycles = (cycles << 1)+1;
+        prep_segment->burst_level++;
+      }
+      // A segment may end early in its last burst, which would still take a whole tick. Spread the
+      // segment time over its ticks instead, carrying the cycles left over, so that partial bursts
+      // keep the step rate.
+      uint8_t burst_mask = (1<<prep_segment->burst_level)-1;
+      if (prep_segment->n_step & burst_mask) {
+        uint16_t burst_ticks = (prep_segment->n_step >> prep_segment->burst_level)+1;
+        uint32_t burst_cycles = prep_segment->n_step*((cycles >> prep_segment->burst_level)+1) + prep.burst_cycle_remainder;
+        cycles = burst_cycles/burst_ticks;
+        prep.burst_cycle_remainder = burst_cycles - cycles*burst_ticks;
+        cycles--; // Compare value of the tick period
+      }
+    #endif
 
     #ifdef ADAPTIVE_MULTI_AXIS_STEP_SMOOTHING
       // Compute step timing and multi-axis smoothing level.
@@ -1009,12 +1782,25 @@ void st_prep_buffer()
       else {
         if (cycles < AMASS_LEVEL2) { prep_segment->amass_level = 1; }
         else if (cycles < AMASS_LEVEL3) { prep_segment->amass_level = 2; }
-        else { prep_segment->amass_level = 3; }
+        #if MAX_AMASS_LEVEL > 3
+          else if (cycles < AMASS_LEVEL4) { prep_segment->amass_level = 3; }
+          else if (cycles < AMASS_LEVEL5) { prep_segment->amass_level = 4; }
+          else { prep_segment->amass_level = 5; }
+        #else
+          else { prep_segment->amass_level = 3; }
+        #endif
         cycles >>= prep_segment->amass_level;
         prep_segment->n_step <<= prep_segment->amass_level;
       }
-      if (cycles < (1UL << 16)) { prep_segment->cycles_per_tick = cycles; } // < 65536 (4.1ms @ 16MHz)
-      else { prep_segment->cycles_per_tick = 0xffff; } // Just set the slowest speed possible.
+      #if SPT_PERIOD_BITS > 16
+        prep_segment->cycles_per_tick = cycles; // Exact at any rate. No clamping required.
+      #else
+        if (cycles < (1UL << 16)) { prep_segment->cycles_per_tick = cycles; } // < 65536 (4.1ms @ 16MHz)
+        else { prep_segment->cycles_per_tick = 0xffff; } // Just set the slowest speed possible.
+      #endif
+    #elif SPT_PERIOD_BITS > 16
+      // A 32-bit step timer executes the cycles per step directly, without a prescaler.
+      prep_segment->cycles_per_tick = cycles;
     #else
       // Compute step timing and timer prescalar for normal step generation.
       if (cycles < (1UL << 16)) { // < 65536  (4.1ms @ 16MHz)
@@ -1032,15 +1818,19 @@ void st_prep_buffer()
         }
       }
     #endif
+    #endif
 
     // Segment complete! Increment segment buffer indices, so stepper ISR can immediately execute it.
-    segment_buffer_head = segment_next_head;
-    if ( ++segment_next_head == SEGMENT_BUFFER_SIZE ) { segment_next_head = 0; }
+    #ifdef NATIVE_ARC_BLOCKS
+      if (prep_segment->n_step || !pl_block->is_arc)
+    #endif
+    {
+      segment_buffer_head = segment_next_head;
+      if ( ++segment_next_head == SEGMENT_BUFFER_SIZE ) { segment_next_head = 0; }
+    }
 
-    // Update the appropriate planner and segment data.
+    // Update the appropriate planner data.
     pl_block->millimeters = mm_remaining;
-    prep.steps_remaining = n_steps_remaining;
-    prep.dt_remainder = (n_steps_remaining - step_dist_remaining)*inv_rate;
 
     // Check for exit conditions and flag to load next planner block.
     if (mm_remaining == prep.mm_complete) {
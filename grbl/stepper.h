@@ -53,6 +53,12 @@ void st_prep_buffer();
 // Called by planner_recalculate() when the executing block is updated by the new plan.
 void st_update_plan_block_parameters();
 
+#ifdef HOMING_LATCH_TRIGGER_POSITION
+  // Latches homing limit trigger positions, or defers the latch to the end of an interrupted
+  // stepper ISR. Called by the limit pin change interrupt.
+  void st_homing_latch();
+#endif
+
 // Called by realtime status reporting if realtime rate reporting is enabled in config.h.
 float st_get_realtime_rate();
 
@@ -0,0 +1,362 @@
+/*
+  subprogram.c - O-word subprograms stored in EEPROM
+  Part of Grbl
+
+  Copyright (c) 2026 agent
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#include "grbl.h"
+
+#ifdef ENABLE_SUBPROGRAMS
+
+// EEPROM layout. A marker byte is followed by the stored subprograms, each a 16-bit number and its
+// lines as 0-terminated strings, ended by an empty line. A zero number marks the end of the list.
+#define SUBPROGRAM_MARKER 'O'
+#define SUBPROGRAM_ADDR_FIRST (EEPROM_ADDR_SUBPROGRAMS+1)
+#define SUBPROGRAM_ADDR_END   EEPROM_ADDR_SUBPROGRAMS_END
+
+// O-word commands
+#define SUBPROGRAM_INVALID   0
+#define SUBPROGRAM_SUB       1
+#define SUBPROGRAM_ENDSUB    2
+#define SUBPROGRAM_CALL      3
+#define SUBPROGRAM_REPEAT    4
+#define SUBPROGRAM_ENDREPEAT 5
+
+// Definition flags
+#define SUBPROGRAM_FLAG_DISCARD  bit(0) // Check mode. The definition is not stored.
+#define SUBPROGRAM_FLAG_OVERFLOW bit(1) // Out of space. The definition fails at its end.
+
+static const char subprogram_keyword_sub[] PROGMEM = "SUB";
+static const char subprogram_keyword_endsub[] PROGMEM = "ENDSUB";
+static const char subprogram_keyword_call[] PROGMEM = "CALL";
+static const char subprogram_keyword_repeat[] PROGMEM = "REPEAT";
+static const char subprogram_keyword_endrepeat[] PROGMEM = "ENDREPEAT";
+
+static char subprogram_line[LINE_BUFFER_SIZE]; // Stored line being executed. Shared by all levels.
+
+static uint16_t subprogram_recording; // Number of the open definition. Zero if none.
+static uint16_t subprogram_record_entry; // Address of the definition number, written at its end.
+static uint16_t subprogram_record_addr; // Next free byte of the definition.
+static uint8_t subprogram_record_flags;
+
+
+static uint16_t subprogram_get_number(uint16_t addr)
+{
+  return(eeprom_get_char(addr) | (eeprom_get_char(addr+1) << 8));
+}
+
+
+// Writes an EEPROM byte. eeprom_put_char() waits for the previous write with interrupts disabled,
+// for up to 3.4ms. The read waits for it with interrupts enabled instead, so the serial receive
+// interrupt keeps up with a host streaming a definition by character counting.
+static void subprogram_put_char(uint16_t addr, char data)
+{
+  if (eeprom_get_char(addr) != (uint8_t)data) { eeprom_put_char(addr, data); }
+}
+
+
+static void subprogram_put_number(uint16_t addr, uint16_t number)
+{
+  subprogram_put_char(addr, number & 0xff);
+  subprogram_put_char(addr+1, number >> 8);
+}
+
+
+// Returns the address of the subprogram following the one at addr.
+static uint16_t subprogram_next(uint16_t addr)
+{
+  uint8_t line_start = true;
+  addr += 2;
+  while (addr < SUBPROGRAM_ADDR_END) {
+    if (eeprom_get_char(addr++) == 0) {
+      if (line_start) { break; } // Empty line ends the subprogram.
+      line_start = true;
+    } else {
+      line_start = false;
+    }
+  }
+  return(addr);
+}
+
+
+// Returns the address of subprogram number, or of the end of the list, if it is not stored. Zero
+// finds the end of the list. An address past the EEPROM space means the list is corrupt.
+static uint16_t subprogram_find(uint16_t number)
+{
+  uint16_t addr = SUBPROGRAM_ADDR_FIRST;
+  uint16_t stored;
+  while (addr < SUBPROGRAM_ADDR_END-1) {
+    stored = subprogram_get_number(addr);
+    if ((stored == 0) || (stored == number)) { return(addr); }
+    addr = subprogram_next(addr);
+  }
+  return(SUBPROGRAM_ADDR_END);
+}
+
+
+void subprogram_clear()
+{
+  subprogram_put_char(EEPROM_ADDR_SUBPROGRAMS, SUBPROGRAM_MARKER);
+  subprogram_put_number(SUBPROGRAM_ADDR_FIRST, 0);
+}
+
+
+void subprogram_init()
+{
+  if ((eeprom_get_char(EEPROM_ADDR_SUBPROGRAMS) != SUBPROGRAM_MARKER) ||
+      (subprogram_find(0) >= SUBPROGRAM_ADDR_END-1)) {
+    subprogram_clear();
+  }
+}
+
+
+void subprogram_reset()
+{
+  subprogram_recording = 0;
+}
+
+
+// Matches a program memory keyword at index char_counter of line and moves past it, if found.
+static uint8_t subprogram_match(char *line, uint8_t *char_counter, const char *keyword)
+{
+  uint8_t idx = *char_counter;
+  char c;
+  while ((c = pgm_read_byte(keyword++))) {
+    if (line[idx] != c) { return(false); }
+    line_advance(idx);
+  }
+  *char_counter = idx;
+  return(true);
+}
+
+
+// Reads the O-word command of a line starting with 'O'. The number is returned in number and the
+// repeat count, for a repeat command, in count. Returns SUBPROGRAM_INVALID on any format error.
+static uint8_t subprogram_read_command(char *line, uint8_t char_counter, uint16_t *number, uint16_t *count)
+{
+  float value;
+  line_advance(char_counter); // Skip the 'O'.
+  if (!read_float(line, &char_counter, &value)) { return(SUBPROGRAM_INVALID); }
+  if ((value < 1.0) || (value > 65535.0) || (value != truncf(value))) { return(SUBPROGRAM_INVALID); }
+  *number = value;
+
+  uint8_t command;
+  if (subprogram_match(line, &char_counter, subprogram_keyword_sub)) { command = SUBPROGRAM_SUB; }
+  else if (subprogram_match(line, &char_counter, subprogram_keyword_endsub)) { command = SUBPROGRAM_ENDSUB; }
+  else if (subprogram_match(line, &char_counter, subprogram_keyword_call)) { command = SUBPROGRAM_CALL; }
+  else if (subprogram_match(line, &char_counter, subprogram_keyword_endrepeat)) { command = SUBPROGRAM_ENDREPEAT; }
+  else if (subprogram_match(line, &char_counter, subprogram_keyword_repeat)) {
+    command = SUBPROGRAM_REPEAT;
+    if (line[char_counter] != '[') { return(SUBPROGRAM_INVALID); }
+    line_advance(char_counter);
+    if (!read_float(line, &char_counter, &value)) { return(SUBPROGRAM_INVALID); }
+    if ((value < 0.0) || (value > 65535.0) || (value != truncf(value))) { return(SUBPROGRAM_INVALID); }
+    *count = value;
+    if (line[char_counter] != ']') { return(SUBPROGRAM_INVALID); }
+    line_advance(char_counter);
+  } else {
+    return(SUBPROGRAM_INVALID);
+  }
+  if (line[char_counter] != 0) { return(SUBPROGRAM_INVALID); }
+  return(command);
+}
+
+
+// Reads the stored line at addr into the line buffer. Returns the address of the next line.
+static uint16_t subprogram_read_line(uint16_t addr)
+{
+  uint8_t idx = 0;
+  char c;
+  do {
+    c = (addr < SUBPROGRAM_ADDR_END) ? eeprom_get_char(addr++) : 0;
+    if (idx < (LINE_BUFFER_SIZE-1)) { subprogram_line[idx++] = c; }
+  } while (c);
+  subprogram_line[idx] = 0;
+  return(addr);
+}
+
+
+// Finds the end of repeat block number, starting at addr. Returns the address of its endrepeat line
+// and moves addr past it. Returns zero, if the subprogram ends first.
+static uint16_t subprogram_find_block_end(uint16_t *addr, uint16_t number)
+{
+  uint16_t line_addr, match, count;
+  do {
+    line_addr = *addr;
+    *addr = subprogram_read_line(line_addr);
+    if (subprogram_line[0] == 0) { return(0); }
+  } while ((subprogram_line[0] != 'O') ||
+           (subprogram_read_command(subprogram_line, 0, &match, &count) != SUBPROGRAM_ENDREPEAT) ||
+           (match != number));
+  return(line_addr);
+}
+
+
+static uint8_t subprogram_run(uint16_t addr, uint16_t end, uint8_t depth);
+
+// Executes stored subprogram number at nesting level depth.
+static uint8_t subprogram_call(uint16_t number, uint8_t depth)
+{
+  uint16_t addr = subprogram_find(number);
+  if ((addr >= SUBPROGRAM_ADDR_END-1) || (subprogram_get_number(addr) != number)) {
+    // Definitions are not stored in check mode, so a checked program may call its own.
+    if (sys.state == STATE_CHECK_MODE) { return(STATUS_OK); }
+    return(STATUS_SUBPROGRAM_UNDEFINED);
+  }
+  return(subprogram_run(addr+2, SUBPROGRAM_ADDR_END, depth));
+}
+
+
+// Executes the stored lines from addr up to end or the end of the subprogram. Calls and repeat
+// blocks nest by recursion, limited to SUBPROGRAM_MAX_DEPTH levels. Only addresses are kept on
+// the stack, since a line is no longer needed once it is executed or its command is read.
+static uint8_t subprogram_run(uint16_t addr, uint16_t end, uint8_t depth)
+{
+  if (depth > SUBPROGRAM_MAX_DEPTH) { return(STATUS_SUBPROGRAM_OVERFLOW); }
+  uint8_t status_code;
+  uint16_t number, count;
+  while (addr < end) {
+    addr = subprogram_read_line(addr);
+    if (subprogram_line[0] == 0) { break; } // End of subprogram
+
+    protocol_execute_realtime(); // Runtime command check point.
+    if (sys.abort) { return(STATUS_OK); } // Bail to main loop upon system abort.
+
+    if (subprogram_line[0] != 'O') {
+      status_code = gc_execute_line(subprogram_line, 0);
+    } else {
+      switch (subprogram_read_command(subprogram_line, 0, &number, &count)) {
+        case SUBPROGRAM_CALL:
+          status_code = subprogram_call(number, depth+1);
+          break;
+        case SUBPROGRAM_REPEAT: {
+          uint16_t block_start = addr;
+          uint16_t block_end = subprogram_find_block_end(&addr, number);
+          if (!block_end) { return(STATUS_INVALID_STATEMENT); } // Missing endrepeat
+          status_code = STATUS_OK;
+          while (count-- && !status_code && !sys.abort) {
+            status_code = subprogram_run(block_start, block_end, depth+1);
+          }
+          break;
+        }
+        default: status_code = STATUS_INVALID_STATEMENT; // Definitions and stray block ends.
+      }
+    }
+    if (status_code) { return(status_code); }
+  }
+  return(STATUS_OK);
+}
+
+
+// Opens the definition of subprogram number. Its lines are added after the last subprogram, and the
+// number is written at its end, so an unfinished definition is never found.
+static uint8_t subprogram_begin(uint16_t number)
+{
+  subprogram_recording = number;
+  subprogram_record_flags = 0;
+  if (sys.state == STATE_CHECK_MODE) {
+    subprogram_record_flags = SUBPROGRAM_FLAG_DISCARD;
+    return(STATUS_OK);
+  }
+  protocol_buffer_synchronize(); // EEPROM writes stall the step interrupts.
+  if (sys.abort) { return(STATUS_OK); }
+  subprogram_record_entry = subprogram_find(0);
+  subprogram_record_addr = subprogram_record_entry+2;
+  return(STATUS_OK);
+}
+
+
+// Stores a line of the open definition.
+static uint8_t subprogram_store_line(char *line, uint8_t char_counter)
+{
+  if (subprogram_record_flags & SUBPROGRAM_FLAG_DISCARD) { return(STATUS_OK); }
+  if (subprogram_record_flags & SUBPROGRAM_FLAG_OVERFLOW) { return(STATUS_SUBPROGRAM_OVERFLOW); }
+  uint8_t idx = char_counter;
+  uint8_t length = 0;
+  while (line[idx] != 0) {
+    length++;
+    line_advance(idx);
+  }
+  if (length == 0) { return(STATUS_OK); } // Empty or comment line. An empty line ends the subprogram.
+  if (length >= LINE_BUFFER_SIZE) { return(STATUS_OVERFLOW); }
+  // Room for the line, the empty line ending the subprogram and the end marker.
+  if (subprogram_record_addr+length+4 > SUBPROGRAM_ADDR_END) {
+    subprogram_record_flags |= SUBPROGRAM_FLAG_OVERFLOW;
+    return(STATUS_SUBPROGRAM_OVERFLOW);
+  }
+  do {
+    subprogram_put_char(subprogram_record_addr++, line[char_counter]);
+    line_advance(char_counter);
+  } while (length--);
+  return(STATUS_OK);
+}
+
+
+// Closes the open definition and then deletes the subprogram it replaces, so a failed definition
+// keeps the stored one. Subprograms without lines are not stored.
+static uint8_t subprogram_end()
+{
+  uint16_t number = subprogram_recording;
+  subprogram_recording = 0;
+  if (subprogram_record_flags & SUBPROGRAM_FLAG_DISCARD) { return(STATUS_OK); }
+  if (subprogram_record_flags & SUBPROGRAM_FLAG_OVERFLOW) { return(STATUS_SUBPROGRAM_OVERFLOW); }
+  if (subprogram_record_addr != subprogram_record_entry+2) {
+    subprogram_put_char(subprogram_record_addr, 0); // Empty line ending the subprogram
+    subprogram_put_number(subprogram_record_addr+1, 0); // New end marker
+    subprogram_put_number(subprogram_record_entry, number);
+  }
+
+  // Delete the previous subprogram of the same number by moving the following ones and the end
+  // marker down over it. The new one is always last.
+  uint16_t addr = subprogram_find(number);
+  if ((addr != subprogram_record_entry) && (addr < SUBPROGRAM_ADDR_END-1) &&
+      (subprogram_get_number(addr) == number)) {
+    uint16_t next = subprogram_next(addr);
+    uint16_t list_end = subprogram_find(0)+2;
+    while (next < list_end) { subprogram_put_char(addr++, eeprom_get_char(next++)); }
+  }
+  return(STATUS_OK);
+}
+
+
+uint8_t subprogram_execute_line(char *line, uint8_t char_counter)
+{
+  uint16_t number, count;
+  uint8_t command = SUBPROGRAM_INVALID;
+  if (line[char_counter] == 'O') { command = subprogram_read_command(line, char_counter, &number, &count); }
+
+  if (subprogram_recording) {
+    if (command == SUBPROGRAM_ENDSUB) {
+      if (number != subprogram_recording) { return(STATUS_INVALID_STATEMENT); }
+      return(subprogram_end());
+    }
+    if (command == SUBPROGRAM_SUB) { return(STATUS_INVALID_STATEMENT); } // No nested definitions.
+    return(subprogram_store_line(line, char_counter));
+  }
+
+  switch (command) {
+    case SUBPROGRAM_SUB: return(subprogram_begin(number));
+    case SUBPROGRAM_CALL: return(subprogram_call(number, 1));
+    case SUBPROGRAM_INVALID:
+      if (line[char_counter] != 'O') { return(gc_execute_line(line, char_counter)); }
+      return(STATUS_INVALID_STATEMENT);
+  }
+  // Stray ends, and repeat blocks, which need to read their lines again and are stored only.
+  return(STATUS_GCODE_UNSUPPORTED_COMMAND);
+}
+
+#endif
@@ -0,0 +1,41 @@
+/*
+  subprogram.h - O-word subprograms stored in EEPROM
+  Part of Grbl
+
+  Copyright (c) 2026 agent
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef subprogram_h
+#define subprogram_h
+
+#ifdef ENABLE_SUBPROGRAMS
+
+// Checks the stored subprograms at power-up. Clears them, if the EEPROM space holds anything else.
+void subprogram_init();
+
+// Deletes all stored subprograms.
+void subprogram_clear();
+
+// Ends a subprogram definition left open by a system abort. The definition is not stored.
+void subprogram_reset();
+
+// Executes a g-code line starting at index char_counter. O-word lines define and call subprograms,
+// and the lines of an open definition are stored. All other lines go to the g-code parser.
+uint8_t subprogram_execute_line(char *line, uint8_t char_counter);
+
+#endif
+
+#endif
@@ -107,7 +107,7 @@ void system_execute_startup(char *line)
       report_execute_startup_message(line,STATUS_SETTING_READ_FAIL);
     } else {
       if (line[0] != 0) {
-        uint8_t status_code = gc_execute_line(line);
+        uint8_t status_code = gc_execute_line(line, 0);
         report_execute_startup_message(line,status_code);
       }
     }
@@ -133,8 +133,12 @@ uint8_t system_execute_line(char *line)
     case 'J' : // Jogging
       // Execute only if in IDLE or JOG states.
       if (sys.state != STATE_IDLE && sys.state != STATE_JOG) { return(STATUS_IDLE_ERROR); }
+      #ifdef ENABLE_PROGRAM_MODE
+        // Blocks of a running program wait unstarted in IDLE. A jog would start or cancel them.
+        if (sys.program_running) { return(STATUS_IDLE_ERROR); }
+      #endif
       if(line[2] != '=') { return(STATUS_INVALID_STATEMENT); }
-      return(gc_execute_line(line)); // NOTE: $J= is ignored inside g-code parser and used to detect jog motions.
+      return(gc_execute_line(line, 0)); // NOTE: $J= is ignored inside g-code parser and used to detect jog motions.
       break;
     case '$': case 'G': case 'C': case 'X':
       if ( line[2] != 0 ) { return(STATUS_INVALID_STATEMENT); }
@@ -156,6 +160,9 @@ uint8_t system_execute_line(char *line)
             report_feedback_message(MESSAGE_DISABLED);
           } else {
             if (sys.state) { return(STATUS_IDLE_ERROR); } // Requires no alarm mode.
+            #ifdef ENABLE_PROGRAM_MODE
+              if (sys.program_running) { return(STATUS_IDLE_ERROR); }
+            #endif
             sys.state = STATE_CHECK_MODE;
             report_feedback_message(MESSAGE_ENABLED);
           }
@@ -174,6 +181,9 @@ uint8_t system_execute_line(char *line)
     default :
       // Block any system command that requires the state as IDLE/ALARM. (i.e. EEPROM, homing)
       if ( !(sys.state == STATE_IDLE || sys.state == STATE_ALARM) ) { return(STATUS_IDLE_ERROR); }
+      #ifdef ENABLE_PROGRAM_MODE
+        if (sys.program_running) { return(STATUS_IDLE_ERROR); } // Not idle between program blocks.
+      #endif
       switch( line[1] ) {
         case '#' : // Print Grbl NGC parameters
           if ( line[2] != 0 ) { return(STATUS_INVALID_STATEMENT); }
@@ -201,6 +211,45 @@ uint8_t system_execute_line(char *line)
             if (line[2] == 0) { system_execute_startup(line); }
           }
           break;
+        #ifdef ENABLE_MESH_LEVELING
+          case 'M' : // Print, define, enable or store the leveling mesh [IDLE/ALARM]
+            char_counter++;
+            switch (line[char_counter]) {
+              case 0 : report_mesh(); break;
+              case 'E' : case 'D' : case 'W' : // $ME enable, $MD disable, $MW write to EEPROM
+                if (line[3] != 0) { return(STATUS_INVALID_STATEMENT); }
+                if (line[2] == 'W') { mesh_store(); }
+                else { return(mesh_set_enabled(line[2] == 'E')); }
+                break;
+              case '=' : case 'P' : {
+                // $M=x0,y0,dx,dy Defines the grid origin and spacing.
+                // $MP=x0,y0,x1,y1,z_probe,z_retract,feed Probes a new grid over the XY range. [IDLE]
+                float grid[7];
+                uint8_t n_values = 4;
+                if (line[char_counter] == 'P') {
+                  if (sys.state != STATE_IDLE) { return(STATUS_IDLE_ERROR); }
+                  if (line[++char_counter] != '=') { return(STATUS_INVALID_STATEMENT); }
+                  n_values = 7;
+                }
+                for (helper_var=0; helper_var<n_values; helper_var++) {
+                  char_counter++; // Skip '=' or ','
+                  if (!read_float(line, &char_counter, &grid[helper_var])) { return(STATUS_BAD_NUMBER_FORMAT); }
+                  if (line[char_counter] != ((helper_var < n_values-1) ? ',' : 0)) { return(STATUS_INVALID_STATEMENT); }
+                }
+                if (n_values == 7) { return(mc_probe_grid(grid)); }
+                return(mesh_set_grid(grid));
+              }
+              default : // $Mn=z Sets the Z offset of grid point n.
+                if (!read_float(line, &char_counter, &parameter)) { return(STATUS_BAD_NUMBER_FORMAT); }
+                if (line[char_counter++] != '=') { return(STATUS_INVALID_STATEMENT); }
+                if (!read_float(line, &char_counter, &value)) { return(STATUS_BAD_NUMBER_FORMAT); }
+                if ((line[char_counter] != 0) || (parameter < 0.0) || (parameter >= MESH_POINTS_X*MESH_POINTS_Y)) {
+                  return(STATUS_INVALID_STATEMENT);
+                }
+                mesh_set_point(trunc(parameter), value);
+            }
+            break;
+        #endif
         case 'S' : // Puts Grbl to sleep [IDLE/ALARM]
           if ((line[2] != 'L') || (line[3] != 'P') || (line[4] != 0)) { return(STATUS_INVALID_STATEMENT); }
           system_set_exec_state_flag(EXEC_SLEEP); // Set to execute sleep mode immediately
@@ -263,7 +312,7 @@ uint8_t system_execute_line(char *line)
               line[char_counter-helper_var] = line[char_counter];
             } while (line[char_counter++] != 0);
             // Execute gcode block to ensure block is valid.
-            helper_var = gc_execute_line(line); // Set helper_var to returned status code.
+            helper_var = gc_execute_line(line, 0); // Set helper_var to returned status code.
             if (helper_var) { return(helper_var); }
             else {
               helper_var = trunc(parameter); // Set helper_var to int value of parameter
@@ -147,6 +147,15 @@ typedef struct {
   #ifdef VARIABLE_SPINDLE
     float spindle_speed;
   #endif
+  #ifdef PLANNED_ACCESSORY_STATE
+    uint8_t accessory_pending; // Parser spindle or coolant change not yet carried by a queued block.
+  #endif
+  #ifdef ENABLE_BINARY_PROTOCOL
+    uint8_t binary_mode; // Input is read as binary motion records. Cleared by reset.
+  #endif
+  #ifdef ENABLE_PROGRAM_MODE
+    uint8_t program_running; // Between the '%' program delimiters. Cleared by reset.
+  #endif
 } system_t;
 extern system_t sys;
 
@@ -31,6 +31,7 @@
 #include <math.h>
 #include <inttypes.h>
 #include <string.h>
+#include <stddef.h>
 #include <stdlib.h>
 #include <stdint.h>
 #include <stdbool.h>
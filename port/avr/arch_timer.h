@@ -42,6 +42,14 @@
  * - Watchdog timer for DT.
  */
 
+/**
+ * Width of the SPT period in bits. Timer 1 is 16-bit, so slow step rates need a
+ * prescaler (see SPT_PRESCALER) or AMASS to fit. Ports with a 32-bit step timer
+ * define this as 32; SPT_SET() then takes any 32-bit period, the segment generator
+ * skips prescaler selection, and more AMASS levels are enabled.
+ */
+#define SPT_PERIOD_BITS 16
+
 /**
  * Configure Timer 1: Stepper Driver Interrupt
  */
@@ -72,6 +80,15 @@
     OCR1A = period; \
   } while (0)
 
+/**
+ * Set SPT clock prescaler. Only required by 16-bit timers without AMASS.
+ * @param prescaler Timer 1 clock select value: 1 = F_CPU, 2 = F_CPU/8, 3 = F_CPU/64.
+ */
+#define SPT_PRESCALER(prescaler) \
+  do { \
+    TCCR1B = (TCCR1B & ~(0x07<<CS10)) | ((prescaler)<<CS10); \
+  } while (0)
+
 /**
  * Stop SPT interrupts.
  */
@@ -0,0 +1,179 @@
+/*
+  accessory_check.c - checks spindle restores with planned accessory states on the host
+  Part of Grbl
+
+  Copyright (c) 2026 agent
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  Queues a cut with the spindle on, followed by an M5 and the next motion, so the parser state is
+  already past the M5 while the cut executes. The machine is then suspended during the cut by a
+  safety door and by a feed hold with spindle stop override, and its spindle must be off while
+  suspended and back on when the cut resumes. A spindle speed override while idle must also keep
+  the spindle of the queued cut. The suspend loop blocks, so a timer signal stands in for the
+  serial interrupts. It resumes the cycle after a while, and drains and discards the serial output.
+*/
+
+#include <stdio.h>
+#include <signal.h>
+#include <sys/time.h>
+#include <unistd.h>
+#include "grbl.h"
+#include "host.h"
+
+#define CHECK_TICK_US 1000        // Timer signal period
+#define CHECK_RESUME_TICKS 10     // Suspend time before the cycle start
+#define CHECK_TIMEOUT_TICKS 2000  // Suspend time before giving up on a hung suspend loop
+#define CHECK_HOLD_X 2.0          // Hold position in the cut (mm)
+#define CHECK_SPINDLE_RPM 500.0
+
+static volatile uint8_t check_suspended;     // Set by the main program while it is suspended.
+static volatile uint16_t check_ticks;
+static volatile uint8_t check_suspend_spindle; // Spindle output state as the cycle start is sent.
+
+void USART_UDRE_vect(void);
+
+
+static void check_tick(int signal)
+{
+  while (UCSR0B & (1<<UDRIE0)) { USART_UDRE_vect(); }
+  if (check_suspended) {
+    check_ticks++;
+    if (check_ticks == CHECK_RESUME_TICKS) {
+      check_suspend_spindle = spindle_get_state();
+      system_set_exec_state_flag(EXEC_CYCLE_START);
+    } else if (check_ticks == CHECK_TIMEOUT_TICKS) {
+      static const char message[] = "FAIL: suspend did not resume\n";
+      if (write(1, message, sizeof(message)-1)) { }
+      _exit(1);
+    }
+  }
+}
+
+
+static void check_execute(const char *line)
+{
+  char buffer[LINE_BUFFER_SIZE];
+  strcpy(buffer, line);
+  if (gc_execute_line(buffer, 0) != STATUS_OK) {
+    printf("FAIL: %s does not parse\n", line);
+    exit(1);
+  }
+}
+
+
+// Queues the cut, the M5 and the next motion from idle with the spindle off.
+static void check_queue_program()
+{
+  sys.state = STATE_IDLE;
+  plan_reset(); // The coordinate writes of host_init() wait for the motions left by the last check.
+  host_init();
+  spindle_set_state(SPINDLE_DISABLE, 0.0);
+  check_execute("M3S500");
+  check_execute("G1X10F600");
+  check_execute("M5");
+  check_execute("G1X20");
+}
+
+
+// Runs the stepper and the realtime commands, as the main program would, until the given suspend
+// flags are set.
+static void check_run_until(uint8_t suspend)
+{
+  while (!(sys.suspend & suspend)) {
+    TIMER1_COMPA_vect();
+    protocol_exec_rt_system();
+  }
+}
+
+
+// Starts the cut and suspends it with the given realtime command once past the hold position.
+static void check_suspend_cut(uint8_t exec_flag)
+{
+  system_set_exec_state_flag(EXEC_CYCLE_START);
+  protocol_exec_rt_system();
+  while (sys_position[X_AXIS] < CHECK_HOLD_X*settings.steps_per_mm[X_AXIS]) {
+    TIMER1_COMPA_vect();
+    protocol_exec_rt_system();
+  }
+  system_set_exec_state_flag(exec_flag);
+  check_run_until(SUSPEND_HOLD_COMPLETE);
+}
+
+
+// Lets the suspend loop run until the cycle start from the timer resumes it.
+static void check_resume()
+{
+  check_ticks = 0;
+  check_suspended = true;
+  protocol_execute_realtime();
+  check_suspended = false;
+}
+
+
+static uint8_t check_result(const char *name, uint8_t passed)
+{
+  printf("%s: %s\n", (passed ? "PASS" : "FAIL"), name);
+  return(!passed);
+}
+
+
+int main()
+{
+  uint8_t n_failed = 0;
+
+  struct sigaction action;
+  memset(&action, 0, sizeof(action));
+  action.sa_handler = check_tick;
+  sigaction(SIGALRM, &action, NULL);
+  struct itimerval timer = { { 0, CHECK_TICK_US }, { 0, CHECK_TICK_US } };
+  setitimer(ITIMER_REAL, &timer, NULL);
+
+  check_queue_program();
+  system_set_exec_accessory_override_flag(EXEC_SPINDLE_OVR_COARSE_PLUS);
+  protocol_exec_rt_system();
+  n_failed += check_result("idle spindle override keeps the spindle of the queued cut",
+                           (spindle_get_state() == SPINDLE_STATE_CW) &&
+                           (fabs(sys.spindle_speed-1.1*CHECK_SPINDLE_RPM) < 0.5));
+
+  check_queue_program();
+  check_suspend_cut(EXEC_SAFETY_DOOR);
+  check_resume();
+  n_failed += check_result("safety door stops the spindle",
+                           (check_suspend_spindle == SPINDLE_STATE_DISABLE));
+  n_failed += check_result("safety door restores the spindle of the cut",
+                           (sys.state == STATE_CYCLE) && (spindle_get_state() == SPINDLE_STATE_CW));
+
+  check_queue_program();
+  check_suspend_cut(EXEC_FEED_HOLD);
+  system_set_exec_accessory_override_flag(EXEC_SPINDLE_OVR_STOP);
+  check_resume();
+  n_failed += check_result("spindle stop override stops the spindle",
+                           (check_suspend_spindle == SPINDLE_STATE_DISABLE));
+  n_failed += check_result("spindle stop override restores the spindle of the cut",
+                           (sys.state == STATE_CYCLE) && (spindle_get_state() == SPINDLE_STATE_CW));
+
+  // The M5 still applies with the motion after it.
+  while (sys_position[X_AXIS] < 10.0*settings.steps_per_mm[X_AXIS]+1) {
+    TIMER1_COMPA_vect();
+    protocol_exec_rt_system();
+  }
+  n_failed += check_result("M5 stops the spindle with the next motion",
+                           (spindle_get_state() == SPINDLE_STATE_DISABLE));
+
+  if (n_failed) { return(1); }
+  return(0);
+}
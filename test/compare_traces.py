@@ -0,0 +1,98 @@
+#!/usr/bin/env python3
+"""\
+Compares two stepper_trace outputs of the same motions.
+---------------------
+The traces hold the machine position in steps at every millisecond from the start of each motion,
+the time each motion ends, the end time and position, and the number of step timer interrupts.
+Every motion must complete at the same position, and no axis may be more than the tolerance in
+steps apart at the same time into a motion. A motion that ended earlier compares with its end.
+The time of each motion may differ by the time tolerance in percent.
+
+Usage: compare_traces.py [--tolerance STEPS] [--time-tolerance PERCENT] reference.txt candidate.txt
+---------------------
+"""
+
+import argparse
+import sys
+
+AXES = 'XYZ'
+
+def read_trace(path):
+    trace = {'samples': {}, 'lines': {}}
+    with open(path) as f:
+        for line in f:
+            fields = line.split()
+            if fields[0] == 'at':
+                trace['samples'][(int(fields[1]), int(fields[2])//1000)] = [int(v) for v in fields[3:]]
+            elif fields[0] == 'line':
+                trace['lines'][int(fields[1])] = (int(fields[2]), [int(v) for v in fields[3:]])
+            elif fields[0] == 'end':
+                trace['end'] = (int(fields[2]), [int(v) for v in fields[3:]])
+            elif fields[0] == 'interrupts':
+                trace['interrupts'] = int(fields[1])
+    if 'end' not in trace:
+        sys.exit('%s: trace has no end' % path)
+    return trace
+
+def position(trace, key):
+    # A motion that ended earlier stays at its end position.
+    if key in trace['samples']:
+        return trace['samples'][key]
+    if key[0] in trace['lines']:
+        return trace['lines'][key[0]][1]
+    return trace['end'][1]
+
+parser = argparse.ArgumentParser(description='Compares two stepper_trace outputs.')
+parser.add_argument('reference')
+parser.add_argument('candidate')
+parser.add_argument('--tolerance', type=int, default=1, help='maximum position difference (steps)')
+parser.add_argument('--time-tolerance', type=float, default=0.1, help='maximum motion time difference (%%)')
+args = parser.parse_args()
+
+ref = read_trace(args.reference)
+cand = read_trace(args.candidate)
+
+max_diff = [0]*len(AXES)
+max_key = [(0, 0)]*len(AXES)
+for key in sorted(set(ref['samples']) | set(cand['samples'])):
+    ref_pos = position(ref, key)
+    cand_pos = position(cand, key)
+    for idx in range(len(AXES)):
+        diff = abs(ref_pos[idx]-cand_pos[idx])
+        if diff > max_diff[idx]:
+            max_diff[idx] = diff
+            max_key[idx] = key
+
+max_line_diff = 0.0
+max_line = 0
+for line in ref['lines']:
+    if line in cand['lines']:
+        diff = abs(cand['lines'][line][0]-ref['lines'][line][0])/float(ref['lines'][line][0])
+        if diff > max_line_diff:
+            max_line_diff = diff
+            max_line = line
+
+ref_time, ref_end = ref['end']
+cand_time, cand_end = cand['end']
+print('%s against %s' % (args.candidate, args.reference))
+print('  end time: %d us against %d us (%+.3f%%)' % (cand_time, ref_time, 100.0*(cand_time-ref_time)/ref_time))
+print('  end position: %s against %s' % (cand_end, ref_end))
+print('  motions completed: %d against %d' % (len(cand['lines']), len(ref['lines'])))
+print('  motion time: at most %.3f%% apart, motion %d' % (100.0*max_line_diff, max_line))
+print('  step timer interrupts: %d against %d' % (cand['interrupts'], ref['interrupts']))
+for idx in range(len(AXES)):
+    print('  %s: at most %d steps apart, motion %d at %d ms' % ((AXES[idx], max_diff[idx]) + max_key[idx]))
+
+failed = False
+if cand_end != ref_end or sorted(cand['lines']) != sorted(ref['lines']):
+    print('FAIL: motions end at different positions')
+    failed = True
+if max(max_diff) > args.tolerance:
+    print('FAIL: positions more than %d steps apart' % args.tolerance)
+    failed = True
+if 100.0*max_line_diff > args.time_tolerance:
+    print('FAIL: motion times more than %.3f%% apart' % args.time_tolerance)
+    failed = True
+if failed:
+    sys.exit(1)
+print('PASS')
@@ -0,0 +1,147 @@
+/*
+  gcode_check.c - checks the status codes of the g-code parser on the host
+  Part of Grbl
+
+  Copyright (c) 2026 agent
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  Runs g-code lines through the parser in check mode, so no motion is planned, and compares their
+  status codes with the ones Grbl reports. Lines are given as the protocol passes them on, without
+  spaces and in upper case. Then times the parser on a few typical lines.
+*/
+
+#include <stdio.h>
+#include <time.h>
+#include "grbl.h"
+#include "host.h"
+
+#define CHECK_BENCH_RUNS 50     // Reports the fastest run, which is the least disturbed by the host.
+#define CHECK_BENCH_PASSES 1000 // Passes over the lines per run
+
+typedef struct {
+  const char *line;
+  uint8_t status;
+} check_line_t;
+
+static const check_line_t check_lines[] = {
+  { "G0X1", STATUS_OK },
+  { "G1X1F100", STATUS_OK },
+  { "G49", STATUS_OK },
+  { "G49.5", STATUS_OK }, // Any G49.x is G49.
+  { "G43", STATUS_GCODE_UNSUPPORTED_COMMAND },
+  { "G38.1", STATUS_GCODE_UNSUPPORTED_COMMAND },
+  { "G1G43", STATUS_GCODE_AXIS_COMMAND_CONFLICT }, // Conflicts before the decimal value is checked.
+  { "G1G38", STATUS_GCODE_AXIS_COMMAND_CONFLICT },
+  { "G1G0.5", STATUS_GCODE_AXIS_COMMAND_CONFLICT },
+  { "G28.2", STATUS_GCODE_UNSUPPORTED_COMMAND },
+  { "G1G28.2", STATUS_GCODE_UNSUPPORTED_COMMAND },
+  { "G90.1", STATUS_GCODE_UNSUPPORTED_COMMAND },
+  { "G91.2", STATUS_GCODE_UNSUPPORTED_COMMAND },
+  { "G61.1", STATUS_GCODE_UNSUPPORTED_COMMAND },
+  { "G60", STATUS_GCODE_UNSUPPORTED_COMMAND },
+  { "M60", STATUS_GCODE_UNSUPPORTED_COMMAND },
+  { "G1G43.1Z1", STATUS_GCODE_AXIS_COMMAND_CONFLICT },
+  { "G43.1Z1", STATUS_OK },
+  { "G28.1", STATUS_OK },
+  { "G1G28.1F100", STATUS_OK }, // G28.1 may follow a motion command.
+  { "G0.5", STATUS_GCODE_COMMAND_VALUE_NOT_INTEGER },
+  { "G4.5", STATUS_GCODE_COMMAND_VALUE_NOT_INTEGER },
+  { "G59.1", STATUS_GCODE_COMMAND_VALUE_NOT_INTEGER },
+  { "M3.5", STATUS_GCODE_COMMAND_VALUE_NOT_INTEGER },
+  { "G1G10.5", STATUS_GCODE_COMMAND_VALUE_NOT_INTEGER },
+  { "G1X1G28", STATUS_GCODE_AXIS_COMMAND_CONFLICT },
+  { "G17G18", STATUS_GCODE_MODAL_GROUP_VIOLATION },
+  { "G1X1X2", STATUS_GCODE_WORD_REPEATED },
+  { "M3S100", STATUS_OK },
+  { "M5", STATUS_OK },
+  { "M2", STATUS_OK },
+  { "G94", STATUS_OK }, // Lookup edges and codes with several entries.
+  { "G92.1", STATUS_OK },
+  { "G38.4Z-1F10", STATUS_OK },
+  { "G100", STATUS_GCODE_UNSUPPORTED_COMMAND },
+  { "M9", STATUS_OK },
+  { "M31", STATUS_GCODE_UNSUPPORTED_COMMAND },
+};
+
+// Typical program lines for timing the parser.
+static const char *bench_lines[] = {
+  "G0X10Y20Z5",
+  "G1X12.5Y-3.25F600",
+  "G2X17.5Y1.75I5J0",
+  "G21G90G17G94G54",
+  "M3S12000",
+  "G4P0.5",
+  "N100G1Z-1.5F120M8",
+  "G92X0Y0Z0",
+};
+
+#define N_CHECK_LINES (sizeof(check_lines)/sizeof(check_line_t))
+#define N_BENCH_LINES (sizeof(bench_lines)/sizeof(char *))
+
+
+static uint8_t check_execute(const char *line)
+{
+  char buffer[LINE_BUFFER_SIZE];
+  strcpy(buffer, line);
+  return(gc_execute_line(buffer, 0));
+}
+
+
+int main()
+{
+  host_init();
+  sys.state = STATE_CHECK_MODE;
+
+  uint8_t idx;
+  uint8_t n_failed = 0;
+  for (idx=0; idx<N_CHECK_LINES; idx++) {
+    gc_init(); // Each line starts from the power-up modal state.
+    uint8_t status = check_execute(check_lines[idx].line);
+    if (status != check_lines[idx].status) {
+      printf("FAIL: %s gives error %u, expected %u\n", check_lines[idx].line, status, check_lines[idx].status);
+      n_failed++;
+    }
+  }
+  printf("%u of %u lines give the expected status\n", (unsigned)(N_CHECK_LINES-n_failed), (unsigned)N_CHECK_LINES);
+
+  struct timespec start, end;
+  uint32_t pass;
+  gc_init();
+  for (idx=0; idx<N_BENCH_LINES; idx++) { // Time only lines that parse all the way through.
+    if (check_execute(bench_lines[idx]) != STATUS_OK) {
+      printf("FAIL: %s does not parse\n", bench_lines[idx]);
+      return(1);
+    }
+  }
+  double ns_best = 0.0;
+  uint8_t run;
+  for (run=0; run<CHECK_BENCH_RUNS; run++) {
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (pass=0; pass<CHECK_BENCH_PASSES; pass++) {
+      for (idx=0; idx<N_BENCH_LINES; idx++) { check_execute(bench_lines[idx]); }
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double ns = (end.tv_sec-start.tv_sec)*1e9 + (end.tv_nsec-start.tv_nsec);
+    if ((run == 0) || (ns < ns_best)) { ns_best = ns; }
+  }
+  printf("parse time: %.1f ns/line, fastest of %u runs of %lu lines\n",
+         ns_best/((double)CHECK_BENCH_PASSES*N_BENCH_LINES), CHECK_BENCH_RUNS,
+         (unsigned long)CHECK_BENCH_PASSES*N_BENCH_LINES);
+
+  if (n_failed) { return(1); }
+  return(0);
+}
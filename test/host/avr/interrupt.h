@@ -0,0 +1,29 @@
+/*
+  interrupt.h - host stand-in for the AVR interrupt definitions
+  Part of Grbl
+
+  Copyright (c) 2026 agent
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef _host_avr_interrupt_h
+#define _host_avr_interrupt_h
+
+// Interrupt handlers become plain functions named by their vector, called by the host program.
+#define ISR(vector) void vector(void)
+#define sei()
+#define cli()
+
+#endif
@@ -0,0 +1,79 @@
+/*
+  io.h - host stand-in for the AVR register definitions
+  Part of Grbl
+
+  Copyright (c) 2026 agent
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef _host_avr_io_h
+#define _host_avr_io_h
+
+#include <stdint.h>
+
+// Registers are plain variables, defined in host.c. Bit numbers are those of the ATmega328P, so
+// the step timer period and prescaler written by the stepper module can be read back.
+#ifndef HOST_REGISTER
+  #define HOST_REGISTER(type,name) extern volatile type name;
+#endif
+
+HOST_REGISTER(uint8_t,SREG)
+HOST_REGISTER(uint8_t,DDRB)   HOST_REGISTER(uint8_t,DDRC)   HOST_REGISTER(uint8_t,DDRD)
+HOST_REGISTER(uint8_t,PORTB)  HOST_REGISTER(uint8_t,PORTC)  HOST_REGISTER(uint8_t,PORTD)
+HOST_REGISTER(uint8_t,PINB)   HOST_REGISTER(uint8_t,PINC)   HOST_REGISTER(uint8_t,PIND)
+HOST_REGISTER(uint8_t,PCICR)  HOST_REGISTER(uint8_t,PCMSK0) HOST_REGISTER(uint8_t,PCMSK1)
+HOST_REGISTER(uint8_t,TCCR0A) HOST_REGISTER(uint8_t,TCCR0B) HOST_REGISTER(uint8_t,TCNT0)
+HOST_REGISTER(uint8_t,OCR0A)  HOST_REGISTER(uint8_t,TIMSK0)
+HOST_REGISTER(uint8_t,TCCR1A) HOST_REGISTER(uint8_t,TCCR1B) HOST_REGISTER(uint16_t,TCNT1)
+HOST_REGISTER(uint16_t,OCR1A) HOST_REGISTER(uint8_t,TIMSK1)
+HOST_REGISTER(uint8_t,TCCR2A) HOST_REGISTER(uint8_t,TCCR2B) HOST_REGISTER(uint8_t,OCR2A)
+HOST_REGISTER(uint8_t,UCSR0A) HOST_REGISTER(uint8_t,UCSR0B) HOST_REGISTER(uint8_t,UDR0)
+HOST_REGISTER(uint8_t,UBRR0H) HOST_REGISTER(uint8_t,UBRR0L)
+HOST_REGISTER(uint8_t,MCUSR)  HOST_REGISTER(uint8_t,WDTCSR)
+
+#define CS01   1
+#define OCIE0A 1
+#define OCIE0B 2
+#define TOIE0  0
+#define CS10   0
+#define CS11   1
+#define CS12   2
+#define WGM10  0
+#define WGM11  1
+#define WGM12  3
+#define WGM13  4
+#define COM1B0 4
+#define COM1B1 5
+#define COM1A0 6
+#define COM1A1 7
+#define OCIE1A 1
+#define CS22   2
+#define WGM20  0
+#define WGM21  1
+#define COM2A1 7
+#define PCIE0  0
+#define PCIE1  1
+#define U2X0   1
+#define TXEN0  3
+#define RXEN0  4
+#define UDRIE0 5
+#define RXCIE0 7
+#define WDP0   0
+#define WDE    3
+#define WDRF   3
+#define WDCE   4
+#define WDIE   6
+
+#endif
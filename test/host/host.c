@@ -0,0 +1,104 @@
+/*
+  host.c - registers, EEPROM and system globals of the host builds
+  Part of Grbl
+
+  Copyright (c) 2026 agent
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#define HOST_REGISTER(type,name) volatile type name;
+#include "grbl.h"
+#include "host.h"
+
+
+// System globals, declared in main.c on the target.
+system_t sys;
+int32_t sys_position[N_AXIS];
+int32_t sys_probe_position[N_AXIS];
+volatile uint8_t sys_probe_state;
+volatile uint8_t sys_rt_exec_state;
+volatile uint8_t sys_rt_exec_alarm;
+volatile uint8_t sys_rt_exec_motion_override;
+volatile uint8_t sys_rt_exec_accessory_override;
+#ifdef DEBUG
+  volatile uint8_t sys_rt_exec_debug;
+#endif
+
+
+// EEPROM contents. Replaces port/avr/eeprom.c, which drives the EEPROM registers.
+static unsigned char host_eeprom[1024];
+
+unsigned char eeprom_get_char(unsigned int addr)
+{
+  return(host_eeprom[addr % sizeof(host_eeprom)]);
+}
+
+void eeprom_put_char(unsigned int addr, unsigned char new_value)
+{
+  host_eeprom[addr % sizeof(host_eeprom)] = new_value;
+}
+
+void memcpy_to_eeprom_with_checksum(unsigned int destination, char *source, unsigned int size)
+{
+  unsigned char checksum = 0;
+  for(; size > 0; size--) {
+    checksum = (checksum << 1) | (checksum >> 7);
+    checksum += *source;
+    eeprom_put_char(destination++, *(source++));
+  }
+  eeprom_put_char(destination, checksum);
+}
+
+int memcpy_from_eeprom_with_checksum(char *destination, unsigned int source, unsigned int size)
+{
+  unsigned char data, checksum = 0;
+  for(; size > 0; size--) {
+    data = eeprom_get_char(source++);
+    checksum = (checksum << 1) | (checksum >> 7);
+    checksum += data;
+    *(destination++) = data;
+  }
+  return(checksum == eeprom_get_char(source));
+}
+
+
+// Brings the core up like main() does at power-up, with default settings and an erased EEPROM.
+void host_init()
+{
+  memset(host_eeprom, 0xff, sizeof(host_eeprom));
+  settings_restore(SETTINGS_RESTORE_ALL);
+  settings_init();
+  stepper_init();
+  memset(&sys, 0, sizeof(system_t));
+  memset(sys_position, 0, sizeof(sys_position));
+  sys.state = STATE_IDLE;
+  sys.f_override = DEFAULT_FEED_OVERRIDE;
+  sys.r_override = DEFAULT_RAPID_OVERRIDE;
+  sys.spindle_speed_ovr = DEFAULT_SPINDLE_SPEED_OVERRIDE;
+  gc_init();
+  plan_reset();
+  st_reset();
+  plan_sync_position();
+  gc_sync_position();
+}
+
+
+// Step timer clock cycles until the next Stepper Driver Interrupt. Timer 1 runs in CTC mode, so the
+// period is one cycle longer than the compare value.
+uint32_t host_step_timer_period()
+{
+  static const uint16_t prescaler[8] = { 0, 1, 8, 64, 256, 1024, 0, 0 };
+  return((OCR1A+1UL)*prescaler[(TCCR1B >> CS10) & 0x07]);
+}
@@ -0,0 +1,33 @@
+/*
+  host.h - registers, EEPROM and system globals of the host builds
+  Part of Grbl
+
+  Copyright (c) 2026 agent
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef host_h
+#define host_h
+
+// Interrupt handlers of the core, called by the host programs.
+void TIMER1_COMPA_vect(void);
+
+// Brings the core up like main() does at power-up, with default settings and an erased EEPROM.
+void host_init();
+
+// Step timer clock cycles until the next Stepper Driver Interrupt.
+uint32_t host_step_timer_period();
+
+#endif
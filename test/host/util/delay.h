@@ -0,0 +1,28 @@
+/*
+  delay.h - host stand-in for the AVR busy wait delays
+  Part of Grbl
+
+  Copyright (c) 2026 agent
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+#ifndef _host_util_delay_h
+#define _host_util_delay_h
+
+// Delays return at once. Host programs keep their own simulated time.
+#define _delay_ms(ms) do {} while (0)
+#define _delay_us(us) do {} while (0)
+
+#endif
@@ -0,0 +1,85 @@
+/*
+  read_float_check.c - checks the rounding of read_float() on the host
+  Part of Grbl
+
+  Copyright (c) 2026 agent
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  Compares read_float() with the correctly rounded strtof() on values of up to 7 significant
+  digits with 1 to 6 decimals, the range g-code uses. Then times read_float() on a few typical
+  g-code values.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "grbl.h"
+
+#define CHECK_STRIDE 7 // Checks every 7th mantissa, which covers all last digits.
+#define CHECK_BENCH_PASSES 200000
+
+// Typical g-code values for timing read_float().
+static const char *bench_values[] = { "10", "12.5", "-3.25", "0.001", "120.0125", "-0.5", "600", "35.79" };
+
+#define N_BENCH_VALUES (sizeof(bench_values)/sizeof(char *))
+
+
+int main()
+{
+  char buffer[32];
+  uint8_t char_counter;
+  float value;
+  uint32_t mantissa;
+  uint8_t decimals;
+  uint32_t n_values = 0;
+  uint32_t n_failed = 0;
+  for (decimals=1; decimals<=6; decimals++) {
+    for (mantissa=0; mantissa<10000000; mantissa+=CHECK_STRIDE) {
+      uint32_t scale = 1;
+      uint8_t idx;
+      for (idx=0; idx<decimals; idx++) { scale *= 10; }
+      sprintf(buffer, "%lu.%0*lu", (unsigned long)(mantissa/scale), decimals, (unsigned long)(mantissa%scale));
+      char_counter = 0;
+      if (!read_float(buffer, &char_counter, &value) || (value != strtof(buffer, NULL))) {
+        if (n_failed < 10) { printf("FAIL: %s reads as %.9g, expected %.9g\n", buffer, value, strtof(buffer, NULL)); }
+        n_failed++;
+      }
+      n_values++;
+    }
+  }
+  printf("%lu of %lu values read correctly rounded\n", (unsigned long)(n_values-n_failed), (unsigned long)n_values);
+
+  struct timespec start, end;
+  uint32_t pass;
+  uint8_t idx;
+  volatile float sum = 0.0;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  for (pass=0; pass<CHECK_BENCH_PASSES; pass++) {
+    for (idx=0; idx<N_BENCH_VALUES; idx++) {
+      char_counter = 0;
+      read_float((char *)bench_values[idx], &char_counter, &value);
+      sum += value;
+    }
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  double ns = (end.tv_sec-start.tv_sec)*1e9 + (end.tv_nsec-start.tv_nsec);
+  printf("read time: %.1f ns/value over %lu values\n", ns/((double)CHECK_BENCH_PASSES*N_BENCH_VALUES),
+         (unsigned long)CHECK_BENCH_PASSES*N_BENCH_VALUES);
+
+  if (n_failed) { return(1); }
+  return(0);
+}
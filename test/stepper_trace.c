@@ -0,0 +1,161 @@
+/*
+  stepper_trace.c - traces the step output of the planner and stepper modules on the host
+  Part of Grbl
+
+  Copyright (c) 2026 agent
+
+  Grbl is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  Grbl is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with Grbl.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+  Feeds a fixed set of motions to the planner and runs the Stepper Driver Interrupt against a
+  simulated step timer, refilling the segment buffer between interrupts like the main program does.
+  The machine position in steps is printed every millisecond from the start of each motion, so time
+  differences of earlier motions do not accumulate, and the end time of each motion when its target
+  is reached. The end time, final position and number of interrupts follow. Builds of different
+  stepper options trace the same motions, so compare_traces.py can compare their output.
+*/
+
+#include <stdio.h>
+#include "grbl.h"
+#include "host.h"
+
+#define TRACE_SAMPLE_CYCLES (F_CPU/1000) // Position sample period (timer cycles)
+#define TRACE_MAX_LINES 64
+
+typedef struct {
+  float target[N_AXIS]; // Absolute machine position (mm)
+  float feed_rate;      // (mm/min) Zero is a rapid motion.
+  int32_t target_steps[N_AXIS];
+} trace_line_t;
+
+static trace_line_t trace_lines[TRACE_MAX_LINES];
+static uint8_t n_trace_lines;
+
+
+static void trace_add(float x, float y, float z, float feed_rate)
+{
+  trace_line_t *line = &trace_lines[n_trace_lines++];
+  line->target[X_AXIS] = x;
+  line->target[Y_AXIS] = y;
+  line->target[Z_AXIS] = z;
+  line->feed_rate = feed_rate;
+}
+
+
+// Motions covering rapids, multi-axis feeds, junctions of short segments and slow feeds, which use
+// the higher AMASS levels or the timer prescaler.
+static void trace_build()
+{
+  uint8_t idx;
+  trace_add(50.0, 20.0, 0.0, 0.0);
+  trace_add(60.0, 25.0, -2.0, 1200.0);
+  for (idx=1; idx<=36; idx++) { // Circle of 36 chords at a feed near the axis rates
+    float angle = idx*(2.0*M_PI/36);
+    trace_add(50.0+10.0*cos(angle), 25.0+10.0*sin(angle), -2.0, 3000.0);
+  }
+  trace_add(61.0, 25.0, -2.0, 10.0);
+  trace_add(61.5, 25.3, -2.1, 30.0);
+  trace_add(10.0, 70.0, 5.0, 2500.0);
+  trace_add(0.0, 0.0, 0.0, 0.0);
+}
+
+
+// Machine settings with step rates from a few Hz up to 20kHz. Max rates are a little off round
+// numbers, so that no rapid cruises at a whole number of timer cycles per step. The float ceil()
+// of the reference rounds those on its own round-off, up on some segments and not on others, and
+// positions would drift apart by a few steps against any other rounding.
+static void trace_settings()
+{
+  settings.steps_per_mm[X_AXIS] = 200.0;
+  settings.steps_per_mm[Y_AXIS] = 160.0;
+  settings.steps_per_mm[Z_AXIS] = 400.0;
+  settings.max_rate[X_AXIS] = 5990.0;
+  settings.max_rate[Y_AXIS] = 5990.0;
+  settings.max_rate[Z_AXIS] = 990.0;
+  settings.acceleration[X_AXIS] = 300.0*60*60;
+  settings.acceleration[Y_AXIS] = 300.0*60*60;
+  settings.acceleration[Z_AXIS] = 50.0*60*60;
+}
+
+
+static void trace_print(const char *label, uint8_t line_index, uint64_t time)
+{
+  printf("%s %u %llu %ld %ld %ld\n", label, line_index, (unsigned long long)(time/TICKS_PER_MICROSECOND),
+         (long)sys_position[X_AXIS], (long)sys_position[Y_AXIS], (long)sys_position[Z_AXIS]);
+}
+
+
+int main()
+{
+  host_init();
+  trace_settings();
+  trace_build();
+
+  uint8_t idx;
+  for (idx=0; idx<n_trace_lines*N_AXIS; idx++) { // Same rounding as the planner
+    trace_lines[idx/N_AXIS].target_steps[idx%N_AXIS] =
+      lround(trace_lines[idx/N_AXIS].target[idx%N_AXIS]*settings.steps_per_mm[idx%N_AXIS]);
+  }
+
+  plan_line_data_t pl_data;
+  uint8_t line_index = 0; // Next line to queue
+  uint8_t exec_index = 0; // Line executing
+  uint64_t time = 0; // Simulated time (timer cycles)
+  uint64_t line_start = 0;
+  uint64_t next_sample = 0;
+  uint32_t n_interrupts = 0;
+
+  for (;;) {
+    // Queue motions while the planner buffer has room, as the protocol loop does.
+    while ((line_index < n_trace_lines) && !plan_check_full_buffer()) {
+      trace_line_t *line = &trace_lines[line_index++];
+      memset(&pl_data, 0, sizeof(plan_line_data_t));
+      if (line->feed_rate == 0.0) { pl_data.condition = PL_COND_FLAG_RAPID_MOTION; }
+      else { pl_data.feed_rate = line->feed_rate; }
+      plan_buffer_line(line->target, &pl_data);
+    }
+    st_prep_buffer();
+    if (sys.state == STATE_IDLE) {
+      sys.state = STATE_CYCLE;
+      st_wake_up();
+    }
+
+    // Samples hold the position between interrupts, so they are independent of the interrupt rate.
+    while (next_sample <= time) {
+      trace_print("at", exec_index, next_sample-line_start);
+      next_sample += TRACE_SAMPLE_CYCLES;
+    }
+    TIMER1_COMPA_vect();
+    n_interrupts++;
+    if ((exec_index < n_trace_lines) &&
+        !memcmp(sys_position, trace_lines[exec_index].target_steps, sizeof(sys_position))) {
+      trace_print("line", exec_index, time-line_start);
+      exec_index++;
+      line_start = time;
+      next_sample = time + TRACE_SAMPLE_CYCLES;
+    }
+    if (sys_rt_exec_state & EXEC_CYCLE_STOP) {
+      if (line_index < n_trace_lines) {
+        fprintf(stderr, "segment buffer ran empty at %llu us\n", (unsigned long long)(time/TICKS_PER_MICROSECOND));
+        return(1);
+      }
+      break;
+    }
+    time += host_step_timer_period();
+  }
+  trace_print("end", exec_index, time);
+  printf("interrupts %lu\n", (unsigned long)n_interrupts);
+  return(0);
+}